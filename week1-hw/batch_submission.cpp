@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "vv-aes-batch.h"
+
+/*
+ * Prints one block in the same format as writeOutput().
+ */
+void write_block(const uint8_t block[BLOCK_SIZE][BLOCK_SIZE]) {
+    for (int row = 0; row < BLOCK_SIZE; row++) {
+        std::cout << std::hex << (int) block[row][0] << (int) block[row][1] << (int) block[row][2]
+                  << (int) block[row][3];
+    }
+    std::cout << std::dec << std::endl;
+}
+
+/*
+ * Batch encryption driver. Input is the seed followed by an optional number of blocks (default BATCH_LANES).
+ * Block 0 is the regular message, so its line matches the output of sequential_implementation for the same seed.
+ * All other blocks are the message XORed with pseudo random bytes drawn after the keys.
+ */
+int main() {
+    readInput();
+    batch_build_substitution_table();
+
+    int numBlocks = BATCH_LANES;
+    std::cin >> numBlocks;
+    if (numBlocks < 1) {
+        numBlocks = 1;
+    }
+
+    std::vector<BlockBatch> batches((numBlocks + BATCH_LANES - 1) / BATCH_LANES);
+    uint8_t block[BLOCK_SIZE][BLOCK_SIZE];
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int row = 0; row < BLOCK_SIZE; ++row) {
+            for (int column = 0; column < BLOCK_SIZE; ++column) {
+                block[row][column] = b == 0 ? message[row][column] : message[row][column] ^ (rand() & 0xff);
+            }
+        }
+        batch_load(batches[b / BATCH_LANES], b % BATCH_LANES, block);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (auto &batch : batches) {
+        batch_encrypt(batch, allKeys, ITERATIONS);
+    }
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    for (int b = 0; b < numBlocks; ++b) {
+        batch_store(batches[b / BATCH_LANES], b % BATCH_LANES, block);
+        write_block(block);
+    }
+    std::cout << "DONE" << std::endl;
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cerr << numBlocks << " blocks in " << seconds << " s (" << numBlocks / seconds << " blocks/s)" << std::endl;
+    return 0;
+}
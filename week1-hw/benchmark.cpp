@@ -0,0 +1,163 @@
+/*
+ * Microbenchmark for the VV-AES primitives of one implementation.
+ *
+ * The implementation is included as source, so the benchmark calls exactly the functions the submission runs. Its main
+ * is renamed out of the way. Build one binary per implementation:
+ *   g++ -O3 -march=native -DBENCHMARK_SOURCE='"student_submission.cpp"' -o benchmark_student benchmark.cpp
+ * (see the benchmark target in the Makefile). Every implementation keeps the state in the global message, takes the
+ * current key from key and provides the four steps as functions without arguments.
+ *
+ * For every step and for a full round (set_next_key + the four steps) this prints
+ *  - ns/op: wall time per call,
+ *  - cycles/byte: core cycles per call divided by the 49 bytes of the block,
+ *  - instructions/op: retired instructions per call.
+ * Cycles and instructions come from the hardware counters (perf_event_open). If those are not available, e.g. in a
+ * container or with perf_event_paranoid > 2, cycles fall back to the time stamp counter, which ticks at the nominal
+ * frequency instead of the actual one, and instructions are not reported.
+ */
+
+#ifndef BENCHMARK_SOURCE
+#error "Define BENCHMARK_SOURCE as the implementation to benchmark, e.g. -DBENCHMARK_SOURCE='\"vvaes.cpp\"'"
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <x86intrin.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#define main submission_main
+#include BENCHMARK_SOURCE
+#undef main
+
+/*
+ * Retired instructions and core cycles of this thread, counted in user space only.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        cycles = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+        instructions = cycles < 0 ? -1 : open_counter(PERF_COUNT_HW_INSTRUCTIONS, cycles);
+    }
+
+    ~PerfCounters() {
+        if (instructions >= 0)
+            close(instructions);
+        if (cycles >= 0)
+            close(cycles);
+    }
+
+    bool available() const { return instructions >= 0; }
+
+    void start() {
+        ioctl(cycles, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(cycles, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void stop(uint64_t &cycleCount, uint64_t &instructionCount) {
+        ioctl(cycles, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // PERF_FORMAT_GROUP: number of counters, then the values in the order the counters were opened.
+        uint64_t values[3] = {};
+        if (read(cycles, values, sizeof(values)) < (ssize_t) sizeof(values)) {
+            cycleCount = instructionCount = 0;
+            return;
+        }
+        cycleCount = values[1];
+        instructionCount = values[2];
+    }
+
+private:
+    static int open_counter(uint64_t config, int groupLeader) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = groupLeader < 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return (int) syscall(SYS_perf_event_open, &attr, 0, -1, groupLeader, 0);
+    }
+
+    int cycles;
+    int instructions;
+};
+
+PerfCounters counters;
+
+/*
+ * Keeps the compiler from dropping or merging calls whose only effect is on the global message.
+ */
+inline void clobber() {
+    asm volatile("" : : : "memory");
+}
+
+/*
+ * Calls op in batches until minSeconds have passed and prints one line of results.
+ */
+template<typename Operation>
+void measure(const char *name, Operation op, double minSeconds = 0.2) {
+    constexpr long BATCH = 256;
+
+    // Warm up caches and branch predictors.
+    for (long i = 0; i < BATCH; ++i) {
+        op();
+        clobber();
+    }
+
+    long calls = 0;
+    uint64_t cycleCount = 0, instructionCount = 0;
+    if (counters.available())
+        counters.start();
+    const uint64_t tscStart = __rdtsc();
+    const auto start = std::chrono::steady_clock::now();
+    double seconds;
+    do {
+        for (long i = 0; i < BATCH; ++i) {
+            op();
+            clobber();
+        }
+        calls += BATCH;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < minSeconds);
+    const uint64_t tscStop = __rdtsc();
+    if (counters.available())
+        counters.stop(cycleCount, instructionCount);
+    else
+        cycleCount = tscStop - tscStart;
+
+    const double bytes = (double) BLOCK_SIZE * BLOCK_SIZE;
+    printf("%-18s %12.2f %14.3f", name, 1e9 * seconds / calls, (double) cycleCount / calls / bytes);
+    if (counters.available())
+        printf(" %17.1f\n", (double) instructionCount / calls);
+    else
+        printf(" %17s\n", "n/a");
+}
+
+int main() {
+    srand(1);
+    generate_keys();
+    set_next_key();
+
+    printf("%s\n", BENCHMARK_SOURCE);
+    printf("%-18s %12s %14s %17s\n", "operation", "ns/op",
+           counters.available() ? "cycles/byte" : "TSC ticks/byte", "instructions/op");
+    measure("substitute_bytes", [] { substitute_bytes(); });
+    measure("shift_rows", [] { shift_rows(); });
+    measure("mix_columns", [] { mix_columns(); });
+    measure("add_key", [] { add_key(); });
+    measure("round", [] {
+        set_next_key();
+        substitute_bytes();
+        shift_rows();
+        mix_columns();
+        add_key();
+    });
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "vv-aes.h"
+#include "vv-aes-context.h"
+#include "vv-aes-cycle.h"
+
+/*
+ * Cycle analysis mode: ./cycle_submission [iterations]
+ * Encrypts the message like sequential_implementation, but looks for a repeating state on the way (see
+ * vv-aes-cycle.h) and skips the remaining full periods if it finds one. Without a repetition it falls back to the full
+ * computation at no extra cost, so the output always matches the other implementations. What the search found is
+ * reported on stderr.
+ */
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? atoi(argv[1]) : ITERATIONS;
+
+    std::cout << "READY" << std::endl;
+    unsigned int seed = 0;
+    std::cin >> seed;
+    std::cerr << "Using seed " << seed << std::endl;
+
+    const VvAesContext context(seed, iterations);
+    const CycleReport report = encrypt_block_skipping_cycles(context, message);
+
+    writeOutput();
+
+    if (report.length > 0) {
+        std::cerr << "State repeats with period " << report.length << " x " << ROUNDS << " iterations (noticed after "
+                  << report.position << " periods); evaluated " << report.evaluations << " of " << report.steps
+                  << " periods" << std::endl;
+    } else {
+        std::cerr << "No repeating state within " << report.steps << " periods of " << ROUNDS
+                  << " iterations; computed all of them" << std::endl;
+    }
+    return 0;
+}
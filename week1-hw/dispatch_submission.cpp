@@ -0,0 +1,20 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "vv-aes-dispatch.h"
+
+/*
+ * Portable build of the encryption: compiled without -march, it picks the scalar, SSE4.1, AVX2 or AVX-512 kernel at
+ * startup depending on what the CPU supports. Set VV_AES_KERNEL to force one of them.
+ */
+int main() {
+    readInput();
+
+    const DispatchLevel level = dispatch_select();
+    std::cerr << "Using the " << dispatchNames[level] << " kernel" << std::endl;
+    dispatchKernels[level](message, allKeys, ITERATIONS);
+
+    writeOutput();
+    return 0;
+}
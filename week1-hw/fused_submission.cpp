@@ -0,0 +1,19 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "vv-aes-fused.h"
+
+/*
+ * Single-stream encryption with the register-resident round kernel. Input and output are the same as for
+ * sequential_implementation.
+ */
+int main() {
+    readInput();
+    fused_prepare(allKeys);
+
+    fused_encrypt(message, ITERATIONS);
+
+    writeOutput();
+    return 0;
+}
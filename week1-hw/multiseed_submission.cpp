@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+#include "vv-aes.h"
+#include "vv-aes-context.h"
+
+/*
+ * Multi-seed throughput driver. Every seed is an independent encryption job of the standard message. Jobs are handed
+ * out to a fixed pool of worker threads through an atomic counter. Each job gets its own VvAesContext (key schedule and
+ * random state) on the worker's stack, so nothing but the job list and the result slots is shared.
+ *
+ * Usage: ./multiseed_submission [-t threads] [seed-file]
+ * Seeds are read from seed-file, or from stdin if no file is given, until end of input. The result of every seed is
+ * printed on its own line, in input order, in the same format as writeOutput().
+ */
+
+struct Result {
+    uint8_t message[BLOCK_SIZE][BLOCK_SIZE];
+};
+
+void worker(const std::vector<unsigned int> &seeds, std::vector<Result> &results, std::atomic<size_t> &nextJob) {
+    for (size_t i = nextJob.fetch_add(1); i < seeds.size(); i = nextJob.fetch_add(1)) {
+        const VvAesContext context(seeds[i]);
+        memcpy(results[i].message, message, sizeof(results[i].message));
+        context.encrypt_block(results[i].message);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    const char *seedFile = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            numThreads = std::max(1, atoi(argv[++i]));
+        } else {
+            seedFile = argv[i];
+        }
+    }
+
+    std::vector<unsigned int> seeds;
+    std::ifstream file;
+    if (seedFile) {
+        file.open(seedFile);
+        if (!file) {
+            std::cerr << "Cannot open seed file " << seedFile << std::endl;
+            return 1;
+        }
+    }
+    std::istream &input = seedFile ? file : std::cin;
+    unsigned int seed;
+    while (input >> seed) {
+        seeds.push_back(seed);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<Result> results(seeds.size());
+    std::atomic<size_t> nextJob(0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < std::min<size_t>(numThreads, seeds.size()); ++t) {
+        threads.emplace_back(worker, std::cref(seeds), std::ref(results), std::ref(nextJob));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        std::cout << std::dec << seeds[i] << " ";
+        for (const auto &row : results[i].message) {
+            std::cout << std::hex << (int) row[0] << (int) row[1] << (int) row[2] << (int) row[3];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "DONE" << std::endl;
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cerr << std::dec << seeds.size() << " seeds on " << threads.size() << " threads in " << seconds << " s ("
+              << seeds.size() / seconds << " seeds/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,20 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "vv-aes-context.h"
+
+/*
+ * Streaming encryption with the reentrant library: ./stream_submission seed < plain > cipher
+ * stdin is encrypted in 49-byte blocks (the last one zero padded), every block with the full VV-AES schedule.
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " seed < input > output" << std::endl;
+        return 1;
+    }
+
+    const VvAesContext context(strtoul(argv[1], nullptr, 10));
+    const size_t blocks = context.encrypt(std::cin, std::cout);
+    std::cerr << "Encrypted " << blocks << " blocks" << std::endl;
+    return 0;
+}
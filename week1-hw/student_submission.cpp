@@ -2,6 +2,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "vv-aes-mix.h"
+
 constexpr int BLOCK_SIZE = 7;
 constexpr int UNIQUE_CHARACTERS = 256;
 constexpr int ROUNDS = 9;
@@ -33,7 +35,7 @@ uint8_t allKeys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE];
  */
 const uint8_t (*key)[BLOCK_SIZE];
 
-const uint8_t polynomialCoefficients[BLOCK_SIZE][BLOCK_SIZE] = {
+constexpr uint8_t polynomialCoefficients[BLOCK_SIZE][BLOCK_SIZE] = {
         { 3, 1, 6, 5, 9, 4, 3},
         { 9, 6, 3, 8, 5, 2, 1},
         { 1, 2, 3, 4, 5, 6, 7},
@@ -119,37 +121,18 @@ inline void shift_rows() {
     std::rotate(message[6],message[6] + 6, message[6] + BLOCK_SIZE);
 }
 
-inline constexpr uint8_t power(uint8_t x, uint8_t y)
-{
-    uint8_t temp = 0;
-    if(y < 1)
-        return 1;
-    temp = power(x, y/2);
-    if (y%2)
-        return x*temp*temp;
-    else
-        return temp*temp;
-}
-
 /*
  * This function evaluates four different polynomials, one for each row in the column.
  * Each polynomial evaluated is of the form
  * m'[row, column] = c[r][3] m[3][column]^4 + c[r][2] m[2][column]^3 + c[r][1] m[1][column]^2 + c[r][0]m[0][column]^1
  * where m' is the new message value, c[r] is an array of polynomial coefficients for the current result row (each
  * result row gets a different polynomial), and m is the current message value.
- *
+ * Every term c[r][d] * m^(d+1) is precomputed at compile time, so a term is a single byte load.
  */
-uint8_t powers[256][BLOCK_SIZE+1];
+alignas(64) constexpr MixTerms<BLOCK_SIZE> mixTerms = make_mix_terms(polynomialCoefficients);
 
 inline void mix_columns() {
-    for (uint8_t column = 0; column < BLOCK_SIZE; ++column) {
-        for (uint8_t row = 0; row < BLOCK_SIZE; ++row) {
-            uint8_t result = 0;
-            for (uint8_t degree = 0; degree < BLOCK_SIZE; ++degree)
-                result += polynomialCoefficients[row][degree] * powers[message[degree][column]][1+degree];
-            message[row][column] = result;
-        }
-    }
+    mix_columns_with_terms(message, mixTerms);
 }
 
 /*
@@ -170,12 +153,6 @@ int main() {
     // Receive the problem from the system.
     readInput();
 
-    for(uint16_t i = 0; i < 256; ++i) {
-        for (uint8_t j = 0; j < BLOCK_SIZE+1; ++j) {
-            powers[i][j] = power(i, j);
-        }
-    }
-
     // For extra security (and because Vars wasn't able to find enough test messages to keep you occupied) each message
     // is put through VV-AES lots of times. If we can't stop the adverse Masters from decrypting our highly secure
     // encryption scheme, we can at least slow them down.
@@ -0,0 +1,185 @@
+//
+// Batch (multi-message) mode for VV-AES.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_BATCH_H
+#define ASSIGNMENTS_VV_AES_BATCH_H
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <immintrin.h>
+
+#include "vv-aes.h"
+
+/*
+ * Number of independent blocks encrypted side by side. One cell of the 7x7 block holds this many bytes, which is one
+ * zmm register, two ymm registers or four xmm registers.
+ */
+constexpr int BATCH_LANES = 64;
+
+/*
+ * A batch of BATCH_LANES messages in structure-of-arrays layout: lanes[row][column] holds byte (row, column) of every
+ * message in the batch. Each step of a round then works on whole vectors instead of single bytes.
+ */
+struct BlockBatch {
+    alignas(64) uint8_t lanes[BLOCK_SIZE][BLOCK_SIZE][BATCH_LANES];
+};
+
+/*
+ * The substitution from originalCharacter to substitutedCharacter as a direct 256-entry lookup table.
+ */
+alignas(64) uint8_t substitutionTable[UNIQUE_CHARACTERS];
+
+inline void batch_build_substitution_table() {
+    for (int i = 0; i < UNIQUE_CHARACTERS; ++i) {
+        substitutionTable[originalCharacter[i]] = substitutedCharacter[i];
+    }
+}
+
+/*
+ * Copy a single 7x7 block into / out of the given lane of the batch.
+ */
+inline void batch_load(BlockBatch &batch, int lane, const uint8_t block[BLOCK_SIZE][BLOCK_SIZE]) {
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            batch.lanes[row][column][lane] = block[row][column];
+}
+
+inline void batch_store(const BlockBatch &batch, int lane, uint8_t block[BLOCK_SIZE][BLOCK_SIZE]) {
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            block[row][column] = batch.lanes[row][column][lane];
+}
+
+/*
+ * Step 2.1 for every message in the batch. The 256-entry table does not fit into a single shuffle, so it is split:
+ * with VBMI two 128-entry vpermi2b lookups are blended on the top bit of the index, with AVX2 sixteen 16-entry pshufb
+ * lookups are blended on the high nibble.
+ */
+inline void batch_substitute_bytes(BlockBatch &batch) {
+    uint8_t *cell = &batch.lanes[0][0][0];
+#if defined(__AVX512VBMI__)
+    const __m512i t0 = _mm512_load_si512(substitutionTable);
+    const __m512i t1 = _mm512_load_si512(substitutionTable + 64);
+    const __m512i t2 = _mm512_load_si512(substitutionTable + 128);
+    const __m512i t3 = _mm512_load_si512(substitutionTable + 192);
+    for (int i = 0; i < BLOCK_SIZE * BLOCK_SIZE * BATCH_LANES; i += 64) {
+        const __m512i x = _mm512_load_si512(cell + i);
+        const __m512i low = _mm512_permutex2var_epi8(t0, x, t1);
+        const __m512i high = _mm512_permutex2var_epi8(t2, x, t3);
+        _mm512_store_si512(cell + i, _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), low, high));
+    }
+#elif defined(__AVX2__)
+    __m256i tables[UNIQUE_CHARACTERS / 16];
+    for (int k = 0; k < UNIQUE_CHARACTERS / 16; ++k)
+        tables[k] = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *) (substitutionTable + 16 * k)));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    for (int i = 0; i < BLOCK_SIZE * BLOCK_SIZE * BATCH_LANES; i += 32) {
+        const __m256i x = _mm256_load_si256((const __m256i *) (cell + i));
+        const __m256i low = _mm256_and_si256(x, nibble);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+        __m256i result = _mm256_setzero_si256();
+#pragma GCC unroll 16
+        for (int k = 0; k < UNIQUE_CHARACTERS / 16; ++k) {
+            const __m256i hit = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(k));
+            result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(tables[k], low), hit);
+        }
+        _mm256_store_si256((__m256i *) (cell + i), result);
+    }
+#else
+    for (int i = 0; i < BLOCK_SIZE * BLOCK_SIZE * BATCH_LANES; ++i)
+        cell[i] = substitutionTable[cell[i]];
+#endif
+}
+
+/*
+ * Step 2.2 for every message in the batch. Rotating a row moves whole lane vectors around.
+ */
+inline void batch_shift_rows(BlockBatch &batch) {
+    alignas(64) uint8_t rotated[BLOCK_SIZE][BATCH_LANES];
+    for (int row = 1; row < BLOCK_SIZE; ++row) {
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            memcpy(rotated[column], batch.lanes[row][(column + row) % BLOCK_SIZE], BATCH_LANES);
+        memcpy(batch.lanes[row], rotated, sizeof(rotated));
+    }
+}
+
+/*
+ * One cell of the batch as a GCC vector, so the byte arithmetic below is lowered to whatever vector width the target
+ * supports.
+ */
+typedef uint8_t batch_cell __attribute__((vector_size(BATCH_LANES)));
+
+/*
+ * Raises every lane to the given exponent (mod 256).
+ */
+inline void batch_power(batch_cell &result, const batch_cell &value, int exponent) {
+    result = value;
+#pragma GCC unroll 7
+    for (int e = 1; e < exponent; ++e)
+        result *= value;
+}
+
+/*
+ * Step 2.3 for every message in the batch. Like the sequential version, every row is written back right after it is
+ * evaluated, so later rows of the same column already see the updated value and its power. All arithmetic is mod 256.
+ */
+inline void batch_mix_columns(BlockBatch &batch) {
+#pragma GCC unroll 7
+    for (int column = 0; column < BLOCK_SIZE; ++column) {
+        batch_cell powers[BLOCK_SIZE];
+#pragma GCC unroll 7
+        for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+            batch_power(powers[degree], *(batch_cell *) batch.lanes[degree][column], degree + 1);
+
+#pragma GCC unroll 7
+        for (int row = 0; row < BLOCK_SIZE; ++row) {
+            batch_cell result = {};
+#pragma GCC unroll 7
+            for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+                result += polynomialCoefficients[row][degree] * powers[degree];
+            *(batch_cell *) batch.lanes[row][column] = result;
+            batch_power(powers[row], result, row + 1);
+        }
+    }
+}
+
+/*
+ * Step 2.4 for every message in the batch: the same round key is XORed into every lane.
+ */
+inline void batch_add_key(BlockBatch &batch, const uint8_t roundKey[BLOCK_SIZE][BLOCK_SIZE]) {
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            *(batch_cell *) batch.lanes[row][column] ^= roundKey[row][column];
+}
+
+/*
+ * Runs the full VV-AES schedule (ITERATIONS times initial key + ROUNDS rounds + final round) on every message of the
+ * batch. Keys are consumed in the same order as set_next_key() would hand them out, starting at key 0.
+ */
+inline void batch_encrypt(BlockBatch &batch, const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    int nextKey = 0;
+    const uint8_t (*roundKey)[BLOCK_SIZE];
+    for (int i = 0; i < iterations; ++i) {
+        roundKey = keys[nextKey];
+        nextKey = (nextKey + 1) % ROUNDS;
+        batch_add_key(batch, roundKey);
+
+        for (int round = 0; round < ROUNDS; ++round) {
+            roundKey = keys[nextKey];
+            nextKey = (nextKey + 1) % ROUNDS;
+            batch_substitute_bytes(batch);
+            batch_shift_rows(batch);
+            batch_mix_columns(batch);
+            batch_add_key(batch, roundKey);
+        }
+
+        // The final round reuses the key of the last round, just like main() in the sequential implementation.
+        batch_substitute_bytes(batch);
+        batch_shift_rows(batch);
+        batch_add_key(batch, roundKey);
+    }
+}
+
+#endif //ASSIGNMENTS_VV_AES_BATCH_H
@@ -0,0 +1,226 @@
+//
+// Reentrant, header-only VV-AES library.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_CONTEXT_H
+#define ASSIGNMENTS_VV_AES_CONTEXT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <limits>
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#include "vv-aes-mix.h"
+
+/*
+ * The constants of vv-aes.h under names that do not clash with its macros, so both headers can be used together.
+ */
+constexpr int VV_AES_BLOCK_SIZE = 7;
+constexpr int VV_AES_ROUNDS = 9;
+constexpr int VV_AES_ITERATIONS = 400000;
+
+constexpr uint8_t VV_AES_ORIGINAL_CHARACTERS[] = { 65, 187, 34, 76, 23, 80, 84, 133, 165, 185, 236, 164, 252, 248, 237, 82, 59, 94, 191, 75, 60, 228, 87, 138, 96, 67, 66, 101, 225, 154, 215, 136, 85, 224, 173, 213, 112, 117, 182, 18, 19, 51, 15, 180, 36, 43, 40, 39, 181, 118, 77, 146, 160, 208, 83, 227, 211, 26, 33, 193, 230, 150, 140, 158, 99, 155, 111, 1, 3, 253, 127, 190, 55, 238, 62, 31, 56, 57, 108, 52, 14, 53, 115, 141, 151, 42, 79, 149, 68, 188, 98, 48, 121, 41, 199, 156, 144, 179, 72, 216, 130, 107, 174, 29, 0, 123, 197, 240, 113, 5, 212, 116, 161, 198, 110, 218, 50, 73, 35, 209, 38, 64, 157, 9, 220, 46, 22, 124, 168, 6, 25, 128, 58, 186, 45, 147, 159, 234, 8, 153, 100, 207, 222, 81, 32, 194, 88, 204, 17, 232, 21, 170, 103, 119, 152, 195, 132, 241, 162, 30, 192, 166, 137, 104, 4, 125, 97, 70, 49, 91, 92, 102, 221, 177, 172, 254, 247, 11, 134, 183, 169, 245, 12, 255, 178, 249, 20, 203, 16, 200, 148, 95, 251, 63, 2, 71, 229, 167, 24, 109, 189, 10, 129, 246, 219, 214, 243, 231, 93, 7, 105, 78, 106, 235, 54, 244, 171, 89, 250, 90, 184, 239, 143, 142, 47, 139, 206, 242, 74, 114, 86, 44, 226, 120, 61, 126, 13, 28, 176, 163, 175, 202, 196, 223, 210, 145, 201, 69, 135, 37, 122, 217, 27, 233, 205, 131 };
+constexpr uint8_t VV_AES_SUBSTITUTED_CHARACTERS[] = { 83, 54, 64, 63, 84, 239, 167, 136, 218, 230, 28, 157, 129, 158, 223, 67, 46, 172, 130, 110, 133, 237, 150, 192, 171, 169, 38, 98, 217, 164, 14, 137, 30, 221, 55, 94, 162, 16, 128, 57, 174, 117, 93, 52, 175, 189, 109, 186, 140, 2, 205, 21, 246, 49, 254, 249, 179, 74, 12, 123, 23, 56, 203, 224, 187, 0, 66, 103, 180, 65, 115, 91, 42, 240, 39, 154, 85, 199, 8, 248, 222, 131, 215, 34, 18, 226, 244, 6, 68, 252, 81, 209, 45, 142, 11, 127, 124, 41, 119, 242, 60, 145, 188, 77, 13, 101, 25, 200, 156, 255, 27, 1, 201, 232, 149, 185, 95, 53, 51, 50, 152, 177, 114, 125, 165, 61, 161, 236, 44, 106, 36, 122, 210, 62, 166, 132, 184, 69, 47, 88, 5, 143, 253, 148, 134, 245, 212, 73, 112, 250, 75, 155, 211, 183, 76, 153, 214, 3, 15, 58, 195, 144, 118, 96, 116, 207, 146, 139, 190, 235, 31, 70, 198, 229, 206, 247, 104, 78, 111, 120, 105, 82, 231, 160, 228, 4, 108, 22, 126, 107, 176, 170, 208, 97, 113, 241, 251, 238, 100, 216, 141, 233, 197, 89, 135, 72, 194, 181, 29, 225, 86, 79, 121, 17, 227, 168, 7, 99, 71, 204, 9, 151, 19, 219, 234, 213, 37, 243, 90, 147, 178, 163, 24, 182, 10, 35, 43, 33, 191, 202, 159, 59, 32, 196, 87, 48, 26, 220, 138, 102, 20, 92, 80, 40, 193, 173 };
+
+constexpr uint8_t VV_AES_POLYNOMIAL_COEFFICIENTS[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE] = {
+        { 3, 1, 6, 5, 9, 4, 3},
+        { 9, 6, 3, 8, 5, 2, 1},
+        { 1, 2, 3, 4, 5, 6, 7},
+        { 9, 8, 7, 6, 5, 4, 7},
+        { 3, 8, 6, 5, 9, 1, 9},
+        { 3, 5, 2, 8, 7, 9, 2},
+        { 8, 3, 4, 6, 5, 1, 1}
+};
+
+struct VvAesSubstitution {
+    uint8_t table[256];
+};
+
+constexpr VvAesSubstitution make_vv_aes_substitution() {
+    VvAesSubstitution substitution{};
+    for (int i = 0; i < 256; ++i)
+        substitution.table[VV_AES_ORIGINAL_CHARACTERS[i]] = VV_AES_SUBSTITUTED_CHARACTERS[i];
+    return substitution;
+}
+
+alignas(64) inline constexpr VvAesSubstitution vvAesSubstitution = make_vv_aes_substitution();
+alignas(64) inline constexpr MixTerms<VV_AES_BLOCK_SIZE> vvAesMixTerms = make_mix_terms(VV_AES_POLYNOMIAL_COEFFICIENTS);
+
+/*
+ * A private copy of the generator behind glibc's srand()/rand() (the additive feedback generator random() uses with its
+ * default 128-byte state). Seeding it with s yields exactly the numbers rand() returns after srand(s), but every
+ * instance has its own state, so any number of them can run concurrently.
+ */
+class VvAesRandom {
+public:
+    explicit VvAesRandom(unsigned int seed) {
+        // Same initialisation as srandom_r(): a Lehmer sequence computed with Schrage's method, then 310 discarded outputs.
+        int32_t word = seed == 0 ? 1 : (int32_t) seed;
+        state[0] = word;
+        for (int i = 1; i < DEGREE; ++i) {
+            const long hi = word / 127773;
+            const long lo = word % 127773;
+            word = (int32_t) (16807 * lo - 2836 * hi);
+            if (word < 0)
+                word += 2147483647;
+            state[i] = word;
+        }
+        front = SEPARATION;
+        rear = 0;
+        for (int i = 0; i < 10 * DEGREE; ++i)
+            next();
+    }
+
+    int next() {
+        state[front] += state[rear];
+        const int result = (int) (state[front] >> 1);
+        front = front + 1 == DEGREE ? 0 : front + 1;
+        rear = rear + 1 == DEGREE ? 0 : rear + 1;
+        return result;
+    }
+
+private:
+    static constexpr int DEGREE = 31;
+    static constexpr int SEPARATION = 3;
+
+    uint32_t state[DEGREE];
+    int front, rear;
+};
+
+/*
+ * One 7x7 VV-AES block.
+ */
+struct VvAesBlock {
+    uint8_t bytes[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE];
+};
+
+/*
+ * Holds the key schedule for one seed. All encryption entry points are const and keep the message state on the stack,
+ * so one context can be shared by any number of threads, and any number of contexts can be used side by side.
+ */
+class VvAesContext {
+public:
+    explicit VvAesContext(unsigned int seed, int iterations = VV_AES_ITERATIONS) : iterations(iterations) {
+        // Same order and range as generate_keys() in vv-aes.h.
+        VvAesRandom random(seed);
+        for (auto &roundKey : keys)
+            for (auto &row : roundKey)
+                for (auto &column : row)
+                    column = random.next() % std::numeric_limits<uint8_t>::max();
+    }
+
+    /*
+     * Runs the full schedule (iterations x (initial key + ROUNDS rounds + final round)) on one block in place. Keys are
+     * consumed starting with key 0 for every block, like a fresh run of sequential_implementation.
+     */
+    void encrypt_block(uint8_t block[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE]) const {
+        uint8_t state[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE];
+        memcpy(state, block, sizeof(state));
+        encrypt_iterations(state, iterations);
+        memcpy(block, state, sizeof(state));
+    }
+
+    /*
+     * Runs count iterations on state, the first one starting with key firstKey. Returns the key the following iteration
+     * starts with, so a schedule can be split over several calls. Every iteration consumes ROUNDS + 1 keys, so iteration
+     * i of a block starts with key i % ROUNDS.
+     */
+    int encrypt_iterations(uint8_t (&state)[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE], long count, int firstKey = 0) const {
+        int nextKey = firstKey;
+        const uint8_t (*roundKey)[VV_AES_BLOCK_SIZE] = keys[firstKey];
+        for (long i = 0; i < count; ++i) {
+            roundKey = keys[nextKey];
+            nextKey = (nextKey + 1) % VV_AES_ROUNDS;
+            add_key(state, roundKey);
+
+            for (int round = 0; round < VV_AES_ROUNDS; ++round) {
+                roundKey = keys[nextKey];
+                nextKey = (nextKey + 1) % VV_AES_ROUNDS;
+                substitute_bytes(state);
+                shift_rows(state);
+                mix_columns_with_terms(state, vvAesMixTerms);
+                add_key(state, roundKey);
+            }
+
+            // The final round reuses the key of the last round.
+            substitute_bytes(state);
+            shift_rows(state);
+            add_key(state, roundKey);
+        }
+        return nextKey;
+    }
+
+    void encrypt_block(VvAesBlock &block) const {
+        encrypt_block(block.bytes);
+    }
+
+    void encrypt_blocks(VvAesBlock *blocks, size_t count) const {
+        for (size_t i = 0; i < count; ++i)
+            encrypt_block(blocks[i]);
+    }
+
+#ifdef __cpp_lib_span
+    void encrypt_blocks(std::span<VvAesBlock> blocks) const {
+        encrypt_blocks(blocks.data(), blocks.size());
+    }
+#endif
+
+    /*
+     * Encrypts everything from in to out, one 49-byte block at a time. A trailing partial block is padded with zeros,
+     * so the output is always a multiple of 49 bytes. Returns the number of blocks written.
+     */
+    size_t encrypt(std::istream &in, std::ostream &out) const {
+        size_t count = 0;
+        VvAesBlock block;
+        while (true) {
+            memset(&block, 0, sizeof(block));
+            in.read(reinterpret_cast<char *>(block.bytes), sizeof(block.bytes));
+            if (in.gcount() == 0)
+                break;
+            encrypt_block(block);
+            out.write(reinterpret_cast<const char *>(block.bytes), sizeof(block.bytes));
+            ++count;
+            if (in.gcount() < (std::streamsize) sizeof(block.bytes))
+                break;
+        }
+        return count;
+    }
+
+    int iteration_count() const {
+        return iterations;
+    }
+
+    const uint8_t (&round_keys() const)[VV_AES_ROUNDS][VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE] {
+        return keys;
+    }
+
+private:
+    static void substitute_bytes(uint8_t (&state)[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE]) {
+        for (auto &row : state)
+            for (auto &column : row)
+                column = vvAesSubstitution.table[column];
+    }
+
+    static void shift_rows(uint8_t (&state)[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE]) {
+        for (int row = 1; row < VV_AES_BLOCK_SIZE; ++row)
+            std::rotate(state[row], state[row] + row, state[row] + VV_AES_BLOCK_SIZE);
+    }
+
+    static void add_key(uint8_t (&state)[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE],
+                        const uint8_t (*roundKey)[VV_AES_BLOCK_SIZE]) {
+        for (int row = 0; row < VV_AES_BLOCK_SIZE; ++row)
+            for (int column = 0; column < VV_AES_BLOCK_SIZE; ++column)
+                state[row][column] ^= roundKey[row][column];
+    }
+
+    uint8_t keys[VV_AES_ROUNDS][VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE];
+    int iterations;
+};
+
+#endif //ASSIGNMENTS_VV_AES_CONTEXT_H
@@ -0,0 +1,91 @@
+//
+// Cycle detection on the VV-AES iteration, to skip ahead once the state starts repeating.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_CYCLE_H
+#define ASSIGNMENTS_VV_AES_CYCLE_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "vv-aes-context.h"
+
+/*
+ * What the cycle search found. position is the step at which the repetition was noticed; length is zero if none was.
+ */
+struct CycleReport {
+    long steps;
+    long evaluations;
+    long position;
+    long length;
+};
+
+/*
+ * Computes step^steps(state) in place, using Brent's algorithm to notice when the sequence of states becomes periodic.
+ * The hare of Brent's algorithm is the computation itself: it walks the sequence one step at a time towards the target,
+ * and the tortoise only keeps a copy of the state at the last power of two. So if no state repeats, the target is
+ * reached with exactly `steps` evaluations and nothing is wasted on the search. If a state repeats after h steps with
+ * period l, the hare is already on the cycle, and the remaining steps - h evaluations shrink to (steps - h) mod l.
+ * Only two states are kept, so no set of visited states is needed.
+ */
+template<typename State, typename Step>
+CycleReport fast_forward(State &state, long steps, Step step) {
+    CycleReport report = {steps, 0, 0, 0};
+    if (steps == 0)
+        return report;
+
+    State tortoise;
+    memcpy(&tortoise, &state, sizeof(State));
+    step(state);
+    long position = 1;
+    long power = 1;
+    long length = 1;
+    while (memcmp(&tortoise, &state, sizeof(State)) != 0) {
+        if (position == steps) {
+            report.evaluations = position;
+            return report;
+        }
+        if (power == length) {
+            memcpy(&tortoise, &state, sizeof(State));
+            power *= 2;
+            length = 0;
+        }
+        step(state);
+        ++position;
+        ++length;
+    }
+
+    const long remaining = (steps - position) % length;
+    for (long i = 0; i < remaining; ++i)
+        step(state);
+    report.evaluations = position + remaining;
+    report.position = position;
+    report.length = length;
+    return report;
+}
+
+/*
+ * The key schedule starts over every ROUNDS iterations, so ROUNDS iterations starting at key 0 are the same keyed
+ * permutation of the 49-byte state every time. The cycle search runs on that permutation; the iterations that do not
+ * fill a whole period are run normally at the end.
+ */
+struct VvAesState {
+    uint8_t bytes[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE];
+};
+
+inline CycleReport encrypt_block_skipping_cycles(const VvAesContext &context,
+                                                 uint8_t block[VV_AES_BLOCK_SIZE][VV_AES_BLOCK_SIZE]) {
+    VvAesState state;
+    memcpy(state.bytes, block, sizeof(state.bytes));
+
+    const long periods = context.iteration_count() / VV_AES_ROUNDS;
+    CycleReport report = fast_forward(state, periods, [&context](VvAesState &current) {
+        context.encrypt_iterations(current.bytes, VV_AES_ROUNDS);
+    });
+    context.encrypt_iterations(state.bytes, context.iteration_count() % VV_AES_ROUNDS);
+
+    memcpy(block, state.bytes, sizeof(state.bytes));
+    return report;
+}
+
+#endif //ASSIGNMENTS_VV_AES_CYCLE_H
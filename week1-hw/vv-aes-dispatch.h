@@ -0,0 +1,354 @@
+//
+// Runtime CPU dispatch for the VV-AES round kernel.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_DISPATCH_H
+#define ASSIGNMENTS_VV_AES_DISPATCH_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <immintrin.h>
+
+#include "vv-aes.h"
+#include "vv-aes-context.h"
+
+/*
+ * This header is meant to be compiled for the baseline x86-64 target (no -march). Every kernel that needs more than
+ * that carries its own target attribute, and only the selected one is ever called, so the same binary runs on any
+ * x86-64 host and uses the best kernel that host supports.
+ *
+ * The AVX-512 kernel is the fused kernel from vv-aes-fused.h, compiled for AVX-512 BW + VBMI here.
+ */
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512vbmi")
+#define VV_AES_FUSED_TARGET_PRAGMA
+#include "vv-aes-fused.h"
+
+inline void dispatch_encrypt_avx512(uint8_t block[BLOCK_SIZE][BLOCK_SIZE],
+                                    const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    fused_prepare(keys);
+    fused_encrypt(block, iterations);
+}
+#pragma GCC pop_options
+
+typedef void (*DispatchKernel)(uint8_t block[BLOCK_SIZE][BLOCK_SIZE],
+                               const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations);
+
+/*
+ * Plain C++ kernel: one table lookup per byte for substitute_bytes and for every polynomial term in mix_columns.
+ */
+inline void dispatch_substitute_shift_scalar(uint8_t (&state)[BLOCK_SIZE][BLOCK_SIZE]) {
+    for (auto &row : state)
+        for (auto &column : row)
+            column = vvAesSubstitution.table[column];
+    for (int row = 1; row < BLOCK_SIZE; ++row)
+        std::rotate(state[row], state[row] + row, state[row] + BLOCK_SIZE);
+}
+
+inline void dispatch_add_key_scalar(uint8_t (&state)[BLOCK_SIZE][BLOCK_SIZE],
+                                    const uint8_t (*roundKey)[BLOCK_SIZE]) {
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            state[row][column] ^= roundKey[row][column];
+}
+
+inline void dispatch_encrypt_scalar(uint8_t block[BLOCK_SIZE][BLOCK_SIZE],
+                                    const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    uint8_t state[BLOCK_SIZE][BLOCK_SIZE];
+    memcpy(state, block, sizeof(state));
+
+    int nextKey = 0;
+    const uint8_t (*roundKey)[BLOCK_SIZE] = keys[0];
+    for (int i = 0; i < iterations; ++i) {
+        roundKey = keys[nextKey];
+        nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+        dispatch_add_key_scalar(state, roundKey);
+
+        for (int round = 0; round < ROUNDS; ++round) {
+            roundKey = keys[nextKey];
+            nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+            dispatch_substitute_shift_scalar(state);
+            mix_columns_with_terms(state, vvAesMixTerms);
+            dispatch_add_key_scalar(state, roundKey);
+        }
+
+        // The final round reuses the key of the last round.
+        dispatch_substitute_shift_scalar(state);
+        dispatch_add_key_scalar(state, roundKey);
+    }
+
+    memcpy(block, state, sizeof(state));
+}
+
+/*
+ * The SSE4.1 and AVX2 kernels keep one row of the block per register, one column per lane (column 7 is padding), and
+ * work on all columns at once. That turns mix_columns into plain vertical arithmetic: result row r is a sum of
+ * coefficient * power over the rows, using the new values of rows 0..r-1 and the old values of rows r..6. There is no
+ * byte multiply, so the lanes are 16 bits (SSE4.1) or 32 bits (AVX2) wide and only their low byte is meaningful; the
+ * 16-bit multiply gets that byte right for both.
+ */
+
+__attribute__((target("sse4.1")))
+inline __m128i dispatch_widen_sse41(const uint8_t *row) {
+    uint8_t bytes[8] = {};
+    memcpy(bytes, row, BLOCK_SIZE);
+    return _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) bytes));
+}
+
+/*
+ * value^exponent for exponents up to 7 with at most three dependent multiplications.
+ */
+__attribute__((target("sse4.1")))
+inline __m128i dispatch_power_sse41(__m128i value, int exponent) {
+    const __m128i square = _mm_mullo_epi16(value, value);
+    switch (exponent) {
+        case 1: return value;
+        case 2: return square;
+        case 3: return _mm_mullo_epi16(square, value);
+        case 4: return _mm_mullo_epi16(square, square);
+        case 5: return _mm_mullo_epi16(_mm_mullo_epi16(square, square), value);
+        case 6: return _mm_mullo_epi16(_mm_mullo_epi16(square, value), _mm_mullo_epi16(square, value));
+        default: return _mm_mullo_epi16(_mm_mullo_epi16(square, square), _mm_mullo_epi16(square, value));
+    }
+}
+
+__attribute__((target("sse4.1")))
+inline void dispatch_round_sse41(__m128i (&state)[BLOCK_SIZE], const __m128i (&shiftRows)[BLOCK_SIZE],
+                                 const __m128i (&coefficients)[BLOCK_SIZE][BLOCK_SIZE], bool mix) {
+    // SSE has no gather, so the substitution goes through memory.
+    alignas(16) uint16_t lanes[8];
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        _mm_store_si128((__m128i *) lanes, state[row]);
+        const uint8_t *table = vvAesSubstitution.table;
+        state[row] = _mm_setr_epi16(table[lanes[0] & 0xff], table[lanes[1] & 0xff], table[lanes[2] & 0xff],
+                                    table[lanes[3] & 0xff], table[lanes[4] & 0xff], table[lanes[5] & 0xff],
+                                    table[lanes[6] & 0xff], 0);
+        state[row] = _mm_shuffle_epi8(state[row], shiftRows[row]);
+    }
+    if (!mix)
+        return;
+
+    __m128i old[BLOCK_SIZE], raised[BLOCK_SIZE];
+    for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+        old[degree] = dispatch_power_sse41(state[degree], degree + 1);
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        __m128i value = _mm_setzero_si128();
+        for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+            value = _mm_add_epi16(value, _mm_mullo_epi16(degree < row ? raised[degree] : old[degree],
+                                                         coefficients[row][degree]));
+        state[row] = value;
+        raised[row] = dispatch_power_sse41(value, row + 1);
+    }
+}
+
+__attribute__((target("sse4.1")))
+inline void dispatch_encrypt_sse41(uint8_t block[BLOCK_SIZE][BLOCK_SIZE],
+                                   const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    __m128i roundKeys[ROUNDS][BLOCK_SIZE];
+    for (int k = 0; k < ROUNDS; ++k)
+        for (int row = 0; row < BLOCK_SIZE; ++row)
+            roundKeys[k][row] = dispatch_widen_sse41(keys[k][row]);
+
+    // Lane c of row r takes lane (c + r) % 7; the padding lane stays in place.
+    __m128i shiftRows[BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        alignas(16) uint8_t bytes[16];
+        for (int lane = 0; lane < 8; ++lane) {
+            const int source = lane < BLOCK_SIZE ? (lane + row) % BLOCK_SIZE : lane;
+            bytes[2 * lane] = 2 * source;
+            bytes[2 * lane + 1] = 2 * source + 1;
+        }
+        shiftRows[row] = _mm_load_si128((const __m128i *) bytes);
+    }
+
+    __m128i coefficients[BLOCK_SIZE][BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+            coefficients[row][degree] = _mm_set1_epi16(polynomialCoefficients[row][degree]);
+
+    __m128i state[BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        state[row] = dispatch_widen_sse41(block[row]);
+
+    int nextKey = 0;
+    const __m128i *roundKey = roundKeys[0];
+    for (int i = 0; i < iterations; ++i) {
+        for (int round = 0; round <= ROUNDS; ++round) {
+            if (round > 0)
+                dispatch_round_sse41(state, shiftRows, coefficients, true);
+            roundKey = roundKeys[nextKey];
+            nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+            for (int row = 0; row < BLOCK_SIZE; ++row)
+                state[row] = _mm_xor_si128(state[row], roundKey[row]);
+        }
+
+        // The final round reuses the key of the last round.
+        dispatch_round_sse41(state, shiftRows, coefficients, false);
+        for (int row = 0; row < BLOCK_SIZE; ++row)
+            state[row] = _mm_xor_si128(state[row], roundKey[row]);
+    }
+
+    alignas(16) uint16_t lanes[8];
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        _mm_store_si128((__m128i *) lanes, state[row]);
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            block[row][column] = lanes[column];
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256i dispatch_widen_avx2(const uint8_t *row) {
+    uint8_t bytes[8] = {};
+    memcpy(bytes, row, BLOCK_SIZE);
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) bytes));
+}
+
+__attribute__((target("avx2")))
+inline __m256i dispatch_power_avx2(__m256i value, int exponent) {
+    const __m256i square = _mm256_mullo_epi16(value, value);
+    switch (exponent) {
+        case 1: return value;
+        case 2: return square;
+        case 3: return _mm256_mullo_epi16(square, value);
+        case 4: return _mm256_mullo_epi16(square, square);
+        case 5: return _mm256_mullo_epi16(_mm256_mullo_epi16(square, square), value);
+        case 6: return _mm256_mullo_epi16(_mm256_mullo_epi16(square, value), _mm256_mullo_epi16(square, value));
+        default: return _mm256_mullo_epi16(_mm256_mullo_epi16(square, square), _mm256_mullo_epi16(square, value));
+    }
+}
+
+__attribute__((target("avx2")))
+inline void dispatch_round_avx2(__m256i (&state)[BLOCK_SIZE], const int32_t (&table)[UNIQUE_CHARACTERS],
+                                const __m256i (&shiftRows)[BLOCK_SIZE],
+                                const __m256i (&coefficients)[BLOCK_SIZE][BLOCK_SIZE], bool mix) {
+    // One gather substitutes a whole row.
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        state[row] = _mm256_i32gather_epi32(table, _mm256_and_si256(state[row], byteMask), 4);
+        state[row] = _mm256_permutevar8x32_epi32(state[row], shiftRows[row]);
+    }
+    if (!mix)
+        return;
+
+    __m256i old[BLOCK_SIZE], raised[BLOCK_SIZE];
+    for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+        old[degree] = dispatch_power_avx2(state[degree], degree + 1);
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        __m256i value = _mm256_setzero_si256();
+        for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+            value = _mm256_add_epi16(value, _mm256_mullo_epi16(degree < row ? raised[degree] : old[degree],
+                                                               coefficients[row][degree]));
+        state[row] = value;
+        raised[row] = dispatch_power_avx2(value, row + 1);
+    }
+}
+
+__attribute__((target("avx2")))
+inline void dispatch_encrypt_avx2(uint8_t block[BLOCK_SIZE][BLOCK_SIZE],
+                                  const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    alignas(32) int32_t table[UNIQUE_CHARACTERS];
+    for (int i = 0; i < UNIQUE_CHARACTERS; ++i)
+        table[i] = vvAesSubstitution.table[i];
+
+    __m256i roundKeys[ROUNDS][BLOCK_SIZE];
+    for (int k = 0; k < ROUNDS; ++k)
+        for (int row = 0; row < BLOCK_SIZE; ++row)
+            roundKeys[k][row] = dispatch_widen_avx2(keys[k][row]);
+
+    __m256i shiftRows[BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        alignas(32) int32_t lanes[8];
+        for (int lane = 0; lane < 8; ++lane)
+            lanes[lane] = lane < BLOCK_SIZE ? (lane + row) % BLOCK_SIZE : lane;
+        shiftRows[row] = _mm256_load_si256((const __m256i *) lanes);
+    }
+
+    __m256i coefficients[BLOCK_SIZE][BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int degree = 0; degree < BLOCK_SIZE; ++degree)
+            coefficients[row][degree] = _mm256_set1_epi32(polynomialCoefficients[row][degree]);
+
+    __m256i state[BLOCK_SIZE];
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        state[row] = dispatch_widen_avx2(block[row]);
+
+    int nextKey = 0;
+    const __m256i *roundKey = roundKeys[0];
+    for (int i = 0; i < iterations; ++i) {
+        for (int round = 0; round <= ROUNDS; ++round) {
+            if (round > 0)
+                dispatch_round_avx2(state, table, shiftRows, coefficients, true);
+            roundKey = roundKeys[nextKey];
+            nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+            for (int row = 0; row < BLOCK_SIZE; ++row)
+                state[row] = _mm256_xor_si256(state[row], roundKey[row]);
+        }
+
+        // The final round reuses the key of the last round.
+        dispatch_round_avx2(state, table, shiftRows, coefficients, false);
+        for (int row = 0; row < BLOCK_SIZE; ++row)
+            state[row] = _mm256_xor_si256(state[row], roundKey[row]);
+    }
+
+    alignas(32) int32_t lanes[8];
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        _mm256_store_si256((__m256i *) lanes, state[row]);
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            block[row][column] = lanes[column];
+    }
+}
+
+enum DispatchLevel {
+    DISPATCH_SCALAR,
+    DISPATCH_SSE41,
+    DISPATCH_AVX2,
+    DISPATCH_AVX512,
+    DISPATCH_LEVELS
+};
+
+const char *const dispatchNames[DISPATCH_LEVELS] = {"scalar", "sse4.1", "avx2", "avx512"};
+const DispatchKernel dispatchKernels[DISPATCH_LEVELS] = {dispatch_encrypt_scalar, dispatch_encrypt_sse41,
+                                                         dispatch_encrypt_avx2, dispatch_encrypt_avx512};
+
+inline bool dispatch_supported(DispatchLevel level) {
+    __builtin_cpu_init();
+    switch (level) {
+        case DISPATCH_SCALAR: return true;
+        case DISPATCH_SSE41: return __builtin_cpu_supports("sse4.1");
+        case DISPATCH_AVX2: return __builtin_cpu_supports("avx2");
+        case DISPATCH_AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512vbmi");
+        default: return false;
+    }
+}
+
+/*
+ * Picks the best kernel the CPU supports. The environment variable VV_AES_KERNEL (scalar, sse4.1, avx2 or avx512)
+ * forces a specific one for testing; if the CPU cannot run it, the best supported kernel is used instead.
+ */
+inline DispatchLevel dispatch_select() {
+    int best = DISPATCH_LEVELS - 1;
+    while (!dispatch_supported((DispatchLevel) best))
+        --best;
+
+    const char *requested = getenv("VV_AES_KERNEL");
+    if (requested == nullptr || *requested == '\0')
+        return (DispatchLevel) best;
+    for (int level = 0; level < DISPATCH_LEVELS; ++level) {
+        if (strcmp(requested, dispatchNames[level]) == 0) {
+            if (dispatch_supported((DispatchLevel) level))
+                return (DispatchLevel) level;
+            std::cerr << "VV_AES_KERNEL=" << requested << " is not supported by this CPU, using "
+                      << dispatchNames[best] << std::endl;
+            return (DispatchLevel) best;
+        }
+    }
+    std::cerr << "Unknown VV_AES_KERNEL=" << requested << ", using " << dispatchNames[best] << std::endl;
+    return (DispatchLevel) best;
+}
+
+#endif //ASSIGNMENTS_VV_AES_DISPATCH_H
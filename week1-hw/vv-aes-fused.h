@@ -0,0 +1,192 @@
+//
+// Fused, register-resident round kernel for VV-AES.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_FUSED_H
+#define ASSIGNMENTS_VV_AES_FUSED_H
+
+#include <cstdint>
+
+// GCC 12 reports a bogus -Wmaybe-uninitialized inside the AVX-512 intrinsics once they are inlined into the kernels
+// below (GCC bug 105593). Suppressed up to the end of this header only, the diagnostic is popped again there.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+
+#include "vv-aes.h"
+
+// vv-aes-dispatch.h includes this header under #pragma GCC target instead of building everything for AVX-512.
+#if !defined(VV_AES_FUSED_TARGET_PRAGMA) && (!defined(__AVX512BW__) || !defined(__AVX512VBMI__))
+#error "The fused VV-AES kernel needs AVX-512 BW and VBMI (vpermb / vpermi2b)."
+#endif
+
+/*
+ * The whole 7x7 state lives in one zmm register in column-major order with a stride of 8: byte (row, column) sits at
+ * column * 8 + row, so every column is one qword. Row 7 and column 7 are padding. Their contents are never read back and
+ * have a zero coefficient in mix_columns, so whatever ends up there does not matter.
+ */
+constexpr int fused_index(int row, int column) { return column * 8 + row; }
+
+/*
+ * Everything a round needs, prepared once by fused_prepare(). The tables are loaded into registers by the compiler
+ * and stay there for all ITERATIONS.
+ */
+struct FusedTables {
+    __m512i substitution[4];
+    __m512i shiftRows;
+    __m512i pendingCoefficients[BLOCK_SIZE];
+    __m512i keys[ROUNDS];
+};
+
+FusedTables fusedTables;
+
+inline __m512i fused_load(const uint8_t block[BLOCK_SIZE][BLOCK_SIZE]) {
+    alignas(64) uint8_t bytes[64] = {};
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            bytes[fused_index(row, column)] = block[row][column];
+    return _mm512_load_si512(bytes);
+}
+
+inline void fused_store(__m512i state, uint8_t block[BLOCK_SIZE][BLOCK_SIZE]) {
+    alignas(64) uint8_t bytes[64];
+    _mm512_store_si512(bytes, state);
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            block[row][column] = bytes[fused_index(row, column)];
+}
+
+inline void fused_prepare(const uint8_t keys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE]) {
+    alignas(64) uint8_t bytes[UNIQUE_CHARACTERS];
+    for (int i = 0; i < UNIQUE_CHARACTERS; ++i)
+        bytes[originalCharacter[i]] = substitutedCharacter[i];
+    for (int i = 0; i < 4; ++i)
+        fusedTables.substitution[i] = _mm512_load_si512(bytes + 64 * i);
+
+    // Row r is rotated left by r places; padding bytes stay where they are.
+    for (int i = 0; i < 64; ++i)
+        bytes[i] = i;
+    for (int row = 0; row < BLOCK_SIZE; ++row)
+        for (int column = 0; column < BLOCK_SIZE; ++column)
+            bytes[fused_index(row, column)] = fused_index(row, (column + row) % BLOCK_SIZE);
+    fusedTables.shiftRows = _mm512_load_si512(bytes);
+
+    // The coefficients of result row r for the rows it reads before they are updated (degree >= r), repeated in every
+    // column (qword).
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        for (int i = 0; i < 64; ++i)
+            bytes[i] = i % 8 >= row && i % 8 < BLOCK_SIZE ? polynomialCoefficients[row][i % 8] : 0;
+        fusedTables.pendingCoefficients[row] = _mm512_load_si512(bytes);
+    }
+
+    for (int k = 0; k < ROUNDS; ++k)
+        fusedTables.keys[k] = fused_load(keys[k]);
+}
+
+/*
+ * Byte-wise multiplication mod 256. There is no 8-bit multiply, so even and odd bytes go through the 16-bit one.
+ */
+inline __m512i fused_mul_bytes(__m512i a, __m512i b) {
+    const __m512i even = _mm512_mullo_epi16(a, b);
+    const __m512i odd = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+    return _mm512_mask_blend_epi8(0xAAAAAAAAAAAAAAAAull, even, _mm512_slli_epi16(odd, 8));
+}
+
+/*
+ * value^exponent for exponents up to 7 with at most three dependent multiplications. Only the low byte of every
+ * 16-bit lane is meaningful, so garbage in the upper byte is harmless.
+ */
+inline __m512i fused_power(__m512i value, int exponent) {
+    const __m512i square = _mm512_mullo_epi16(value, value);
+    switch (exponent) {
+        case 1: return value;
+        case 2: return square;
+        case 3: return _mm512_mullo_epi16(square, value);
+        case 4: return _mm512_mullo_epi16(square, square);
+        case 5: return _mm512_mullo_epi16(_mm512_mullo_epi16(square, square), value);
+        case 6: return _mm512_mullo_epi16(_mm512_mullo_epi16(square, value), _mm512_mullo_epi16(square, value));
+        default: return _mm512_mullo_epi16(_mm512_mullo_epi16(square, square), _mm512_mullo_epi16(square, value));
+    }
+}
+
+/*
+ * Mask selecting byte `row` of every column.
+ */
+constexpr __mmask64 fused_row_mask(int row) { return 0x0101010101010101ull << row; }
+
+inline __m512i fused_substitute_bytes(__m512i state) {
+    const __m512i low = _mm512_permutex2var_epi8(fusedTables.substitution[0], state, fusedTables.substitution[1]);
+    const __m512i high = _mm512_permutex2var_epi8(fusedTables.substitution[2], state, fusedTables.substitution[3]);
+    return _mm512_mask_blend_epi8(_mm512_movepi8_mask(state), low, high);
+}
+
+inline __m512i fused_shift_rows(__m512i state) {
+    return _mm512_permutexvar_epi8(fusedTables.shiftRows, state);
+}
+
+/*
+ * mix_columns for all columns at once. As in the sequential version every result row is written back immediately, so
+ * row r sees the new values of rows 0..r-1 and the old values of rows r..6. The old part does not depend on any other
+ * result row, so it is computed up front for all rows as a dot product of the incoming powers with the coefficients
+ * (maddubs + madd + folding the two dwords of each column). Only the contributions of already updated rows remain on
+ * the dependency chain; they are kept in the low word of every column and combined with 16-bit multiplies.
+ */
+inline __m512i fused_mix_columns(__m512i state) {
+    // Byte d of every column holds m[d][column]^(d+1).
+    const __m512i square = fused_mul_bytes(state, state);
+    const __m512i cube = fused_mul_bytes(square, state);
+    const __m512i fourth = fused_mul_bytes(square, square);
+    __m512i powers = _mm512_mask_blend_epi8(fused_row_mask(1), state, square);
+    powers = _mm512_mask_blend_epi8(fused_row_mask(2), powers, cube);
+    powers = _mm512_mask_blend_epi8(fused_row_mask(3), powers, fourth);
+    powers = _mm512_mask_blend_epi8(fused_row_mask(4), powers, fused_mul_bytes(fourth, state));
+    powers = _mm512_mask_blend_epi8(fused_row_mask(5), powers, fused_mul_bytes(cube, cube));
+    powers = _mm512_mask_blend_epi8(fused_row_mask(6), powers, fused_mul_bytes(fourth, cube));
+
+    const __m512i ones = _mm512_set1_epi16(1);
+    __m512i raised[BLOCK_SIZE];
+#pragma GCC unroll 7
+    for (int row = 0; row < BLOCK_SIZE; ++row) {
+        __m512i value = _mm512_madd_epi16(_mm512_maddubs_epi16(powers, fusedTables.pendingCoefficients[row]), ones);
+        value = _mm512_add_epi32(value, _mm512_srli_epi64(value, 32));
+#pragma GCC unroll 7
+        for (int degree = 0; degree < row; ++degree)
+            value = _mm512_add_epi16(value, _mm512_mullo_epi16(raised[degree],
+                                                               _mm512_set1_epi16(polynomialCoefficients[row][degree])));
+
+        state = _mm512_mask_blend_epi8(fused_row_mask(row), state, _mm512_slli_epi64(value, 8 * row));
+        raised[row] = fused_power(value, row + 1);
+    }
+    return state;
+}
+
+/*
+ * Runs the full VV-AES schedule on one block. The state is loaded once and only written back at the very end.
+ */
+inline void fused_encrypt(uint8_t block[BLOCK_SIZE][BLOCK_SIZE], int iterations) {
+    __m512i state = fused_load(block);
+    int nextKey = 0;
+    __m512i roundKey;
+    for (int i = 0; i < iterations; ++i) {
+        roundKey = fusedTables.keys[nextKey];
+        nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+        state = _mm512_xor_si512(state, roundKey);
+
+#pragma GCC unroll 9
+        for (int round = 0; round < ROUNDS; ++round) {
+            roundKey = fusedTables.keys[nextKey];
+            nextKey = nextKey + 1 == ROUNDS ? 0 : nextKey + 1;
+            state = fused_mix_columns(fused_shift_rows(fused_substitute_bytes(state)));
+            state = _mm512_xor_si512(state, roundKey);
+        }
+
+        // Final round without mix_columns, reusing the last key.
+        state = fused_shift_rows(fused_substitute_bytes(state));
+        state = _mm512_xor_si512(state, roundKey);
+    }
+    fused_store(state, block);
+}
+
+#pragma GCC diagnostic pop
+
+#endif //ASSIGNMENTS_VV_AES_FUSED_H
@@ -0,0 +1,58 @@
+//
+// Compile-time lookup tables for the VV-AES mix_columns step.
+//
+
+#ifndef ASSIGNMENTS_VV_AES_MIX_H
+#define ASSIGNMENTS_VV_AES_MIX_H
+
+#include <cstdint>
+
+/*
+ * term[row][degree][x] = coefficients[row][degree] * x^(degree + 1) mod 256.
+ * Coefficient and power are folded into a single byte, so one polynomial term is a single load. For the 7x7 block this
+ * is 7 * 7 * 256 bytes = 12.25 KB, which leaves plenty of L1 for the S-box, the keys and the message.
+ */
+template<int N>
+struct MixTerms {
+    uint8_t term[N][N][256];
+};
+
+template<int N>
+constexpr MixTerms<N> make_mix_terms(const uint8_t (&coefficients)[N][N]) {
+    MixTerms<N> terms{};
+    for (int row = 0; row < N; ++row) {
+        for (int degree = 0; degree < N; ++degree) {
+            for (int x = 0; x < 256; ++x) {
+                uint8_t power = 1;
+                for (int e = 0; e <= degree; ++e)
+                    power = power * x;
+                terms.term[row][degree][x] = coefficients[row][degree] * power;
+            }
+        }
+    }
+    return terms;
+}
+
+/*
+ * Evaluates the polynomials of every column. Each result row is written back right away, so later rows of the same
+ * column see the updated values, exactly like multiply_with_polynomial() in the sequential implementation.
+ */
+template<int N>
+inline void mix_columns_with_terms(uint8_t (&state)[N][N], const MixTerms<N> &terms) {
+    for (int column = 0; column < N; ++column) {
+        // Work on a local copy so the column stays in registers instead of going through memory for every row.
+        uint8_t values[N];
+        for (int row = 0; row < N; ++row)
+            values[row] = state[row][column];
+        for (int row = 0; row < N; ++row) {
+            uint8_t result = 0;
+            for (int degree = 0; degree < N; ++degree)
+                result += terms.term[row][degree][values[degree]];
+            values[row] = result;
+        }
+        for (int row = 0; row < N; ++row)
+            state[row][column] = values[row];
+    }
+}
+
+#endif //ASSIGNMENTS_VV_AES_MIX_H
@@ -5,6 +5,8 @@
 
 #include <limits>
 
+#include "vv-aes-mix.h"
+
 constexpr int BLOCK_SIZE = 7;
 constexpr int ROUNDS = 9;
 constexpr int ITERATIONS = 400000;
@@ -35,7 +37,7 @@ uint8_t allKeys[ROUNDS][BLOCK_SIZE][BLOCK_SIZE];
  */
 uint8_t (*key)[BLOCK_SIZE];
 
-const uint8_t polynomialCoefficients[BLOCK_SIZE][BLOCK_SIZE] = {
+constexpr uint8_t polynomialCoefficients[BLOCK_SIZE][BLOCK_SIZE] = {
         { 3, 1, 6, 5, 9, 4, 3},
         { 9, 6, 3, 8, 5, 2, 1},
         { 1, 2, 3, 4, 5, 6, 7},
@@ -168,38 +170,11 @@ inline void shift_rows() {
     }
 }
 
-const int full_retard[BLOCK_SIZE - 3][BLOCK_SIZE][256] = {
-    {
-        { 0, 5, 80, 405, 1280, 3125, 6480, 12005, 20480, 32805, 50000, 73205, 103680, 142805, 192080, 253125, 327680, 417605, 524880, 651605, 800000, 972405, 1171280, 1399205, 1658880, 1953125, 2284880, 2657205, 3073280, 3536405, 4050000, 4617605, 5242880, 5929605, 6681680, 7503125, 8398080, 9370805, 10425680, 11567205, 12800000, 14128805, 15558480, 17094005, 18740480, 20503125, 22387280, 24398405, 26542080, 28824005, 31250000, 33826005, 36558080, 39452405, 42515280, 45753125, 49172480, 52780005, 56582480, 60586805, 64800000, 69229205, 73881680, 78764805, 83886080, 89253125, 94873680, 100755605, 106906880, 113335605, 120050000, 127058405, 134369280, 141991205, 149932880, 158203125, 166810880, 175765205, 185075280, 194750405, 204800000, 215233605, 226060880, 237291605, 248935680, 261003125, 273504080, 286448805, 299847680, 313711205, 328050000, 342874805, 358196480, 374026005, 390374480, 407253125, 424673280, 442646405, 461184080, 480298005, 500000000, 520302005, 541216080, 562754405, 584929280, 607753125, 631238480, 655398005, 680244480, 705790805, 732050000, 759035205, 786759680, 815236805, 844480080, 874503125, 905319680, 936943605, 969388880, 1002669605, 1036800000, 1071794405, 1107667280, 1144433205, 1182106880, 1220703125, 1260236880, 1300723205, 1342177280, 1384614405, 1428050000, 1472499605, 1517978880, 1564503605, 1612089680, 1660753125, 1710510080, 1761376805, 1813369680, 1866505205, 1920800000, 1976270805, 2032934480, 2090808005, -2145058816, -2084714171, -2023108016, -1960222891, -1896041216, -1830545291, -1763717296, -1695539291, -1625993216, -1555060891, -1482724016, -1408964171, -1333762816, -1257101291, -1178960816, -1099322491, -1018167296, -935476091, -851229616, -765408491, -677993216, -588964171, -498301616, -405985691, -311996416, -216313691, -118917296, -19786891, 81097984, 183757909, 288213584, 394485829, 502595584, 612563909, 724411984, 838161109, 953832704, 1071448309, 1191029584, 1312598309, 1436176384, 1561785829, 1689448784, 1819187509, 1951024384, 2084981909, -2073884592, -1935617787, -1795162112, -1652494587, -1507592112, -1360431467, -1210989312, -1059242187, -905166512, -748738587, -589934592, -428730587, -265102512, -99026187, 69522688, 240568533, 414135888, 590249413, 768933888, 950214213, 1134115408, 1320662613, 1509881088, 1701796213, 1896433488, 2093818533, -2000990208, -1798032283, -1592249008, -1383614283, -1172101888, -957685483, -740338608, -520034683, -296747008, -70448763, 158886992, 391287317, 626779392, 865390517, 1107148112, 1352079717, 1600212992, 1851575717, 2106195792, -1930866059, -1669647104, -1405086379, -1137155504, -865825979, -591069184, -312856379, -31158704, 254052821, 542807296, 835133941, 1131062096, 1430621221, 1733840896, 2040750821, -1943586480, -1629206475, -1311046400, -989076075, -663265200, -333583355, },
-        { 0, 8, 128, 648, 2048, 5000, 10368, 19208, 32768, 52488, 80000, 117128, 165888, 228488, 307328, 405000, 524288, 668168, 839808, 1042568, 1280000, 1555848, 1874048, 2238728, 2654208, 3125000, 3655808, 4251528, 4917248, 5658248, 6480000, 7388168, 8388608, 9487368, 10690688, 12005000, 13436928, 14993288, 16681088, 18507528, 20480000, 22606088, 24893568, 27350408, 29984768, 32805000, 35819648, 39037448, 42467328, 46118408, 50000000, 54121608, 58492928, 63123848, 68024448, 73205000, 78675968, 84448008, 90531968, 96938888, 103680000, 110766728, 118210688, 126023688, 134217728, 142805000, 151797888, 161208968, 171051008, 181336968, 192080000, 203293448, 214990848, 227185928, 239892608, 253125000, 266897408, 281224328, 296120448, 311600648, 327680000, 344373768, 361697408, 379666568, 398297088, 417605000, 437606528, 458318088, 479756288, 501937928, 524880000, 548599688, 573114368, 598441608, 624599168, 651605000, 679477248, 708234248, 737894528, 768476808, 800000000, 832483208, 865945728, 900407048, 935886848, 972405000, 1009981568, 1048636808, 1088391168, 1129265288, 1171280000, 1214456328, 1258815488, 1304378888, 1351168128, 1399205000, 1448511488, 1499109768, 1551022208, 1604271368, 1658880000, 1714871048, 1772267648, 1831093128, 1891371008, 1953125000, 2016379008, 2081157128, -2147483648, -2079584248, -2010087296, -1938967928, -1866201088, -1791761528, -1715623808, -1637762296, -1558151168, -1476764408, -1393575808, -1308558968, -1221687296, -1132934008, -1042272128, -949674488, -855113728, -758562296, -659992448, -559376248, -456685568, -351892088, -244967296, -135882488, -24608768, 88882952, 204621952, 322637704, 442959872, 565618312, 690643072, 818064392, 947912704, 1080218632, 1215012992, 1352326792, 1492191232, 1634637704, 1779697792, 1927403272, 2077786112, -2064088824, -1908254592, -1749645944, -1588230144, -1423974264, -1256845184, -1086809592, -913833984, -737884664, -558927744, -376929144, -191854592, -3669624, 187660416, 382170376, 579895296, 780870408, 985131136, 1192713096, 1403652096, 1617984136, 1835745408, 2056972296, -2013265920, -1784997880, -1553153920, -1317696888, -1078589440, -835794040, -589272960, -338988280, -84901888, 173024520, 434829440, 700551560, 970229760, 1243903112, 1521610880, 1803392520, 2089287680, -1915631096, -1621389184, -1322913656, -1020164096, -713099896, -401680256, -85864184, 234389504, 559122184, 888375424, 1222190984, 1560610816, 1903677064, -2043535232, -1691048952, -1333788672, -971711480, -604774272, -232933752, 143853568, 525631368, 912443520, 1304334088, 1701347328, 2103527688, -1784047488, -1371398776, -953448448, -530151288, -101461888, 332665352, 772276224, 1217416712, 1668132992, 2124471432, -1708488704, -1240766072, -767281024, -287986424, 197165056, 688220936, 1185228928, 1688236936, -2097674240, -1582521720, -1061224320, -533733368, },
-        { 0, 4, 64, 324, 1024, 2500, 5184, 9604, 16384, 26244, 40000, 58564, 82944, 114244, 153664, 202500, 262144, 334084, 419904, 521284, 640000, 777924, 937024, 1119364, 1327104, 1562500, 1827904, 2125764, 2458624, 2829124, 3240000, 3694084, 4194304, 4743684, 5345344, 6002500, 6718464, 7496644, 8340544, 9253764, 10240000, 11303044, 12446784, 13675204, 14992384, 16402500, 17909824, 19518724, 21233664, 23059204, 25000000, 27060804, 29246464, 31561924, 34012224, 36602500, 39337984, 42224004, 45265984, 48469444, 51840000, 55383364, 59105344, 63011844, 67108864, 71402500, 75898944, 80604484, 85525504, 90668484, 96040000, 101646724, 107495424, 113592964, 119946304, 126562500, 133448704, 140612164, 148060224, 155800324, 163840000, 172186884, 180848704, 189833284, 199148544, 208802500, 218803264, 229159044, 239878144, 250968964, 262440000, 274299844, 286557184, 299220804, 312299584, 325802500, 339738624, 354117124, 368947264, 384238404, 400000000, 416241604, 432972864, 450203524, 467943424, 486202500, 504990784, 524318404, 544195584, 564632644, 585640000, 607228164, 629407744, 652189444, 675584064, 699602500, 724255744, 749554884, 775511104, 802135684, 829440000, 857435524, 886133824, 915546564, 945685504, 976562500, 1008189504, 1040578564, 1073741824, 1107691524, 1142440000, 1177999684, 1214383104, 1251602884, 1289671744, 1328602500, 1368408064, 1409101444, 1450695744, 1493204164, 1536640000, 1581016644, 1626347584, 1672646404, 1719926784, 1768202500, 1817487424, 1867795524, 1919140864, 1971537604, 2025000000, 2079542404, 2135179264, -2103042172, -2045172672, -1986164796, -1926003712, -1864674492, -1802162112, -1738451452, -1673527296, -1607374332, -1539977152, -1471320252, -1401388032, -1330164796, -1257634752, -1183782012, -1108590592, -1032044412, -954127296, -874822972, -794115072, -711987132, -628422592, -543404796, -456916992, -368942332, -279463872, -188464572, -95927296, -1834812, 93830208, 191085188, 289947648, 390435204, 492565568, 596356548, 701826048, 808992068, 917872704, 1028486148, 1140850688, 1254984708, 1370906688, 1488635204, 1608188928, 1729586628, 1852847168, 1977989508, 2105032704, -2060971388, -1930068928, -1797207868, -1662368768, -1525532092, -1386678208, -1245787388, -1102839808, -957815548, -810694592, -661456828, -510082048, -356549948, -200840128, -42932092, 117194752, 279561092, 444187712, 611095492, 780305408, 951838532, 1125716032, 1301959172, 1480589312, 1661627908, 1845096512, 2031016772, -2075556864, -1884667964, -1691261888, -1495316604, -1296809984, -1095719804, -892023744, -685699388, -476724224, -265075644, -50730944, 166332676, 386138112, 608708356, 834066496, 1062235716, 1293239296, 1527100612, 1763843136, 2003490436, -2048901120, -1803373180, -1554869184, -1303365180, -1048837120, -791260860, -530612160, -266866684, },
-        { 0, 6, 96, 486, 1536, 3750, 7776, 14406, 24576, 39366, 60000, 87846, 124416, 171366, 230496, 303750, 393216, 501126, 629856, 781926, 960000, 1166886, 1405536, 1679046, 1990656, 2343750, 2741856, 3188646, 3687936, 4243686, 4860000, 5541126, 6291456, 7115526, 8018016, 9003750, 10077696, 11244966, 12510816, 13880646, 15360000, 16954566, 18670176, 20512806, 22488576, 24603750, 26864736, 29278086, 31850496, 34588806, 37500000, 40591206, 43869696, 47342886, 51018336, 54903750, 59006976, 63336006, 67898976, 72704166, 77760000, 83075046, 88658016, 94517766, 100663296, 107103750, 113848416, 120906726, 128288256, 136002726, 144060000, 152470086, 161243136, 170389446, 179919456, 189843750, 200173056, 210918246, 222090336, 233700486, 245760000, 258280326, 271273056, 284749926, 298722816, 313203750, 328204896, 343738566, 359817216, 376453446, 393660000, 411449766, 429835776, 448831206, 468449376, 488703750, 509607936, 531175686, 553420896, 576357606, 600000000, 624362406, 649459296, 675305286, 701915136, 729303750, 757486176, 786477606, 816293376, 846948966, 878460000, 910842246, 944111616, 978284166, 1013376096, 1049403750, 1086383616, 1124332326, 1163266656, 1203203526, 1244160000, 1286153286, 1329200736, 1373319846, 1418528256, 1464843750, 1512284256, 1560867846, 1610612736, 1661537286, 1713660000, 1766999526, 1821574656, 1877404326, 1934507616, 1992903750, 2052612096, 2113652166, -2118923680, -2055161050, -1990007296, -1923442330, -1855445920, -1785997690, -1715077120, -1642663546, -1568736160, -1493274010, -1416256000, -1337660890, -1257467296, -1175653690, -1092198400, -1007079610, -920275360, -831763546, -741521920, -649528090, -555759520, -460193530, -362807296, -263577850, -162482080, -59496730, 45401600, 152236454, 261031520, 371810630, 484597760, 599417030, 716292704, 835249190, 956311040, 1079502950, 1204849760, 1332376454, 1462108160, 1594070150, 1728287840, 1864786790, 2003592704, 2144731430, -2006738336, -1860855866, -1712562176, -1561830842, -1408635296, -1252948826, -1094744576, -933995546, -770674592, -604754426, -436207616, -265006586, -91123616, 85469158, 264799744, 446896294, 631787104, 819500614, 1010065408, 1203510214, 1399863904, 1599155494, 1801414144, 2006669158, -2080017312, -1868681082, -1654259712, -1436723322, -1216041888, -992185242, -765123072, -534824922, -301260192, -64398138, 175792128, 419341638, 666281568, 916643238, 1170458112, 1427757798, 1688574048, 1952938758, -2074083328, -1802525434, -1527322528, -1248442138, -965851648, -679518298, -389409184, -95491258, 202268672, 503903942, 809448032, 1118934566, 1432397312, 1749870182, 2071387232, -1897984634, -1568276480, -1234421114, -896383904, -554130074, -207624704, 143167270, 498281056, 857752006, 1221615616, 1589907526, 1962663520, -1955047770, -1573255680, -1186891290, -795918240, -400300026, },
-        { 0, 5, 80, 405, 1280, 3125, 6480, 12005, 20480, 32805, 50000, 73205, 103680, 142805, 192080, 253125, 327680, 417605, 524880, 651605, 800000, 972405, 1171280, 1399205, 1658880, 1953125, 2284880, 2657205, 3073280, 3536405, 4050000, 4617605, 5242880, 5929605, 6681680, 7503125, 8398080, 9370805, 10425680, 11567205, 12800000, 14128805, 15558480, 17094005, 18740480, 20503125, 22387280, 24398405, 26542080, 28824005, 31250000, 33826005, 36558080, 39452405, 42515280, 45753125, 49172480, 52780005, 56582480, 60586805, 64800000, 69229205, 73881680, 78764805, 83886080, 89253125, 94873680, 100755605, 106906880, 113335605, 120050000, 127058405, 134369280, 141991205, 149932880, 158203125, 166810880, 175765205, 185075280, 194750405, 204800000, 215233605, 226060880, 237291605, 248935680, 261003125, 273504080, 286448805, 299847680, 313711205, 328050000, 342874805, 358196480, 374026005, 390374480, 407253125, 424673280, 442646405, 461184080, 480298005, 500000000, 520302005, 541216080, 562754405, 584929280, 607753125, 631238480, 655398005, 680244480, 705790805, 732050000, 759035205, 786759680, 815236805, 844480080, 874503125, 905319680, 936943605, 969388880, 1002669605, 1036800000, 1071794405, 1107667280, 1144433205, 1182106880, 1220703125, 1260236880, 1300723205, 1342177280, 1384614405, 1428050000, 1472499605, 1517978880, 1564503605, 1612089680, 1660753125, 1710510080, 1761376805, 1813369680, 1866505205, 1920800000, 1976270805, 2032934480, 2090808005, -2145058816, -2084714171, -2023108016, -1960222891, -1896041216, -1830545291, -1763717296, -1695539291, -1625993216, -1555060891, -1482724016, -1408964171, -1333762816, -1257101291, -1178960816, -1099322491, -1018167296, -935476091, -851229616, -765408491, -677993216, -588964171, -498301616, -405985691, -311996416, -216313691, -118917296, -19786891, 81097984, 183757909, 288213584, 394485829, 502595584, 612563909, 724411984, 838161109, 953832704, 1071448309, 1191029584, 1312598309, 1436176384, 1561785829, 1689448784, 1819187509, 1951024384, 2084981909, -2073884592, -1935617787, -1795162112, -1652494587, -1507592112, -1360431467, -1210989312, -1059242187, -905166512, -748738587, -589934592, -428730587, -265102512, -99026187, 69522688, 240568533, 414135888, 590249413, 768933888, 950214213, 1134115408, 1320662613, 1509881088, 1701796213, 1896433488, 2093818533, -2000990208, -1798032283, -1592249008, -1383614283, -1172101888, -957685483, -740338608, -520034683, -296747008, -70448763, 158886992, 391287317, 626779392, 865390517, 1107148112, 1352079717, 1600212992, 1851575717, 2106195792, -1930866059, -1669647104, -1405086379, -1137155504, -865825979, -591069184, -312856379, -31158704, 254052821, 542807296, 835133941, 1131062096, 1430621221, 1733840896, 2040750821, -1943586480, -1629206475, -1311046400, -989076075, -663265200, -333583355, },
-        { 0, 8, 128, 648, 2048, 5000, 10368, 19208, 32768, 52488, 80000, 117128, 165888, 228488, 307328, 405000, 524288, 668168, 839808, 1042568, 1280000, 1555848, 1874048, 2238728, 2654208, 3125000, 3655808, 4251528, 4917248, 5658248, 6480000, 7388168, 8388608, 9487368, 10690688, 12005000, 13436928, 14993288, 16681088, 18507528, 20480000, 22606088, 24893568, 27350408, 29984768, 32805000, 35819648, 39037448, 42467328, 46118408, 50000000, 54121608, 58492928, 63123848, 68024448, 73205000, 78675968, 84448008, 90531968, 96938888, 103680000, 110766728, 118210688, 126023688, 134217728, 142805000, 151797888, 161208968, 171051008, 181336968, 192080000, 203293448, 214990848, 227185928, 239892608, 253125000, 266897408, 281224328, 296120448, 311600648, 327680000, 344373768, 361697408, 379666568, 398297088, 417605000, 437606528, 458318088, 479756288, 501937928, 524880000, 548599688, 573114368, 598441608, 624599168, 651605000, 679477248, 708234248, 737894528, 768476808, 800000000, 832483208, 865945728, 900407048, 935886848, 972405000, 1009981568, 1048636808, 1088391168, 1129265288, 1171280000, 1214456328, 1258815488, 1304378888, 1351168128, 1399205000, 1448511488, 1499109768, 1551022208, 1604271368, 1658880000, 1714871048, 1772267648, 1831093128, 1891371008, 1953125000, 2016379008, 2081157128, -2147483648, -2079584248, -2010087296, -1938967928, -1866201088, -1791761528, -1715623808, -1637762296, -1558151168, -1476764408, -1393575808, -1308558968, -1221687296, -1132934008, -1042272128, -949674488, -855113728, -758562296, -659992448, -559376248, -456685568, -351892088, -244967296, -135882488, -24608768, 88882952, 204621952, 322637704, 442959872, 565618312, 690643072, 818064392, 947912704, 1080218632, 1215012992, 1352326792, 1492191232, 1634637704, 1779697792, 1927403272, 2077786112, -2064088824, -1908254592, -1749645944, -1588230144, -1423974264, -1256845184, -1086809592, -913833984, -737884664, -558927744, -376929144, -191854592, -3669624, 187660416, 382170376, 579895296, 780870408, 985131136, 1192713096, 1403652096, 1617984136, 1835745408, 2056972296, -2013265920, -1784997880, -1553153920, -1317696888, -1078589440, -835794040, -589272960, -338988280, -84901888, 173024520, 434829440, 700551560, 970229760, 1243903112, 1521610880, 1803392520, 2089287680, -1915631096, -1621389184, -1322913656, -1020164096, -713099896, -401680256, -85864184, 234389504, 559122184, 888375424, 1222190984, 1560610816, 1903677064, -2043535232, -1691048952, -1333788672, -971711480, -604774272, -232933752, 143853568, 525631368, 912443520, 1304334088, 1701347328, 2103527688, -1784047488, -1371398776, -953448448, -530151288, -101461888, 332665352, 772276224, 1217416712, 1668132992, 2124471432, -1708488704, -1240766072, -767281024, -287986424, 197165056, 688220936, 1185228928, 1688236936, -2097674240, -1582521720, -1061224320, -533733368, },
-        { 0, 6, 96, 486, 1536, 3750, 7776, 14406, 24576, 39366, 60000, 87846, 124416, 171366, 230496, 303750, 393216, 501126, 629856, 781926, 960000, 1166886, 1405536, 1679046, 1990656, 2343750, 2741856, 3188646, 3687936, 4243686, 4860000, 5541126, 6291456, 7115526, 8018016, 9003750, 10077696, 11244966, 12510816, 13880646, 15360000, 16954566, 18670176, 20512806, 22488576, 24603750, 26864736, 29278086, 31850496, 34588806, 37500000, 40591206, 43869696, 47342886, 51018336, 54903750, 59006976, 63336006, 67898976, 72704166, 77760000, 83075046, 88658016, 94517766, 100663296, 107103750, 113848416, 120906726, 128288256, 136002726, 144060000, 152470086, 161243136, 170389446, 179919456, 189843750, 200173056, 210918246, 222090336, 233700486, 245760000, 258280326, 271273056, 284749926, 298722816, 313203750, 328204896, 343738566, 359817216, 376453446, 393660000, 411449766, 429835776, 448831206, 468449376, 488703750, 509607936, 531175686, 553420896, 576357606, 600000000, 624362406, 649459296, 675305286, 701915136, 729303750, 757486176, 786477606, 816293376, 846948966, 878460000, 910842246, 944111616, 978284166, 1013376096, 1049403750, 1086383616, 1124332326, 1163266656, 1203203526, 1244160000, 1286153286, 1329200736, 1373319846, 1418528256, 1464843750, 1512284256, 1560867846, 1610612736, 1661537286, 1713660000, 1766999526, 1821574656, 1877404326, 1934507616, 1992903750, 2052612096, 2113652166, -2118923680, -2055161050, -1990007296, -1923442330, -1855445920, -1785997690, -1715077120, -1642663546, -1568736160, -1493274010, -1416256000, -1337660890, -1257467296, -1175653690, -1092198400, -1007079610, -920275360, -831763546, -741521920, -649528090, -555759520, -460193530, -362807296, -263577850, -162482080, -59496730, 45401600, 152236454, 261031520, 371810630, 484597760, 599417030, 716292704, 835249190, 956311040, 1079502950, 1204849760, 1332376454, 1462108160, 1594070150, 1728287840, 1864786790, 2003592704, 2144731430, -2006738336, -1860855866, -1712562176, -1561830842, -1408635296, -1252948826, -1094744576, -933995546, -770674592, -604754426, -436207616, -265006586, -91123616, 85469158, 264799744, 446896294, 631787104, 819500614, 1010065408, 1203510214, 1399863904, 1599155494, 1801414144, 2006669158, -2080017312, -1868681082, -1654259712, -1436723322, -1216041888, -992185242, -765123072, -534824922, -301260192, -64398138, 175792128, 419341638, 666281568, 916643238, 1170458112, 1427757798, 1688574048, 1952938758, -2074083328, -1802525434, -1527322528, -1248442138, -965851648, -679518298, -389409184, -95491258, 202268672, 503903942, 809448032, 1118934566, 1432397312, 1749870182, 2071387232, -1897984634, -1568276480, -1234421114, -896383904, -554130074, -207624704, 143167270, 498281056, 857752006, 1221615616, 1589907526, 1962663520, -1955047770, -1573255680, -1186891290, -795918240, -400300026, },
-    }, {{ 0, 9, 288, 2187, 9216, 28125, 69984, 151263, 294912, 531441, 900000, 1449459, 2239488, 3341637, 4840416, 6834375, 9437184, 12778713, 17006112, 22284891, 28800000, 36756909, 46382688, 57927087, 71663616, 87890625, 106932384, 129140163, 154893312, 184600341, 218700000, 257662359, 301989888, 352218537, 408918816, 472696875, 544195584, 624095613, 713116512, 812017791, 921600000, 1042705809, 1176221088, 1323075987, 1484246016, 1660753125, 1853666784, 2064105063, -2001731584, -1752690055, -1482467296, -1189740037, -873131008, -531207859, -162482080, 234592079, 661618688, 1120261217, 1612243616, 2139351395, -1591534592, -988567883, -344739104, 341994295, 1073741824, 1852681033, -1613908704, -733775925, 200500224, 1191380253, -2053569184, -941805025, 234389504, 1477775153, -1503776864, -117414605, 1344891904, -1408746363, 214765536, 1923703815, -573571072, 1316288537, -993152480, 1091627419, -1015630848, 1278772461, -611241376, 1908209903, 251232256, -1283072511, 1604492448, 328318211, -812205056, -1812556203, 1626852576, 920807639, 369098752, -23349015, -251506912, -310241429, -194313216, 101623997, 583024480, 1255451583, 2124578816, -1098776367, 181217696, 1675604179, -904459264, 1037202469, -1082988064, 1331378599, -303038464, -1684558407, 1488620576, 633520443, 52188160, -248172403, -260232096, 23464591, 610500608, 1508587425, -1569401184, -25558877, 1853250560, -219703819, -1941084448, 992581239, 0, -615082359, -843749088, -676944117, -105470976, 880008285, -2005993120, -163916449, 2121039872, 563823217, -530537568, -1151832973, -1289704448, -933643323, -72989728, 1303068487, -1089470464, 1350447961, 44164640, -701921061, -876219392, -466981843, 537699936, -2145072081, 86867968, -1344020159, -2130210656, 2035987523, -1717437440, -492526187, 1428979936, -234490857, -1174405120, -1377024983, -828439776, 485435051, -1716108288, 1171300349, 572339040, 796765951, 1859551232, -519121903, -2028954208, 1640536083, 1915112448, -1189342363, 933174752, -291015449, -550502400, 171346169, 1891352608, 331563131, -195849216, 326514637, 1916248160, 296173007, -220758016, 383638241, 2127743648, 735172579, 519674880, 1500235061, -598926624, -1463451209, -1073741824, 590004681, -747168480, -770075061, 541713408, -1086131299, -1337791136, -192202593, -1923055616, 2081076657, -1042999392, 1611543475, 1476914176, -1424524539, 1519744992, 1742592647, -732954624, -1588679015, -801105376, 1653467163, 1503998976, -1225354387, 2079726176, -1441046673, 1122074624, 1204233345, -1169259360, -1677890685, -295879680, -1292176171, -345557792, -1724498089, -1107296256, 1533022057, 1928705824, 107214315, 391218176, -1486301379, -1202182304, 1272017471, 1670021120, 20768593, 648417696, -712556717, 262507520, -691408219, 750866912, 324825127, -1938817024, -1714117575, 1030157344, 2030534587, 1318769664, -1073119475, -817884064, 2117021967, -825524224, -1022509535, 1559412384, -1636077789, -1985160192, 546321525, 1697828576, 1504062711, },
-        { 0, 5, 160, 1215, 5120, 15625, 38880, 84035, 163840, 295245, 500000, 805255, 1244160, 1856465, 2689120, 3796875, 5242880, 7099285, 9447840, 12380495, 16000000, 20420505, 25768160, 32181715, 39813120, 48828125, 59406880, 71744535, 86051840, 102555745, 121500000, 143145755, 167772160, 195676965, 227177120, 262609375, 302330880, 346719785, 396175840, 451120995, 512000000, 579281005, 653456160, 735042215, 824581120, 922640625, 1029814880, 1146725035, 1274019840, 1412376245, 1562500000, 1725126255, 1901020160, 2090977465, -1999142176, -1778545421, -1541308416, -1286507011, -1013183456, -720345801, -406967296, -71985791, 285696864, 667215419, 1073741824, 1506485829, 1966695584, -1839309057, -1320266752, -769777847, -186434592, 431212163, 1084653568, 1775423373, -1789868768, -1019667513, -207275008, 649018897, 1550969952, -1794587189, -795869184, 254052821, 1357122976, -1779633265, -564239360, 710429145, 2046514400, -848757741, 616792064, -2144473827, -540271072, 1136836183, -1405662208, 424680097, -1959504544, 34341211, 2113929216, -12971675, -2048600416, 304862239, -1539607552, 1010894953, -630534688, 2129128867, 703102976, -610431315, -1808197856, 1408109799, 451959808, -378213583, -1078878624, -1646438165, -2077229056, 1927445749, 1781448608, 1783611567, 1937867776, -2046747911, -1576229152, -941401293, -138051584, 838104125, 1991421984, -968636553, 552365056, -2030932031, -123943072, 1983089787, 0, -1773368187, 962906272, -376080065, -1490250752, 1920549257, 1271652320, 863372483, 701136896, 790453709, 1136912672, 1746185735, -1670939648, -518690735, 913887328, -1662166005, 349175808, -1635844075, 978973088, -389956145, -1441225728, 2126658585, 1730377952, 1671604819, 1957134336, -1701115043, -706231776, 653885591, -1908569088, 203592929, -1592215200, 1301383067, 301989888, -287795291, -460244320, -207532449, 478262272, 1605159593, -1113689632, 919866339, -875790336, 2097691885, 1258896160, 911408935, 1063951360, 1725347185, -1390443936, 315543339, -1737490432, 1049629493, 96314272, -293016849, -108805120, 658615609, 2019019488, -312678029, -2031517696, 1167569533, 704861216, 885647799, 1720364032, -1075410431, 1098918752, -335809861, -1073741824, -1103875387, -415093600, 1003836287, -1130703872, 1782686665, 1165657056, 1324876547, -2022801408, -275502067, -2011099872, 1372520519, 1297726464, 2071909009, -587352992, 1922544203, 1024458752, 1026274901, 1941034400, -513062897, -2027756544, 1705340505, 2109840608, -800581485, 1577811968, 669018525, 782067232, 1931150039, -164377600, -1195094239, -1146413728, -3617317, -2046820352, 1328897509, 1548721824, -1372092257, 1171780608, 605932777, 1240995296, -1202197981, 1882226688, 1920412461, -1071423712, 1513009511, 1100274688, 2001977265, -60070304, -773978773, -122683392, 1911023989, 1049528224, 1605293359, -699005952, -1550614663, -931598624, 1176123315, 495812608, 1340813501, -565315552, -908932105, 328788992, -1128143807, -965636256, 835590395, },
-        { 0, 5, 160, 1215, 5120, 15625, 38880, 84035, 163840, 295245, 500000, 805255, 1244160, 1856465, 2689120, 3796875, 5242880, 7099285, 9447840, 12380495, 16000000, 20420505, 25768160, 32181715, 39813120, 48828125, 59406880, 71744535, 86051840, 102555745, 121500000, 143145755, 167772160, 195676965, 227177120, 262609375, 302330880, 346719785, 396175840, 451120995, 512000000, 579281005, 653456160, 735042215, 824581120, 922640625, 1029814880, 1146725035, 1274019840, 1412376245, 1562500000, 1725126255, 1901020160, 2090977465, -1999142176, -1778545421, -1541308416, -1286507011, -1013183456, -720345801, -406967296, -71985791, 285696864, 667215419, 1073741824, 1506485829, 1966695584, -1839309057, -1320266752, -769777847, -186434592, 431212163, 1084653568, 1775423373, -1789868768, -1019667513, -207275008, 649018897, 1550969952, -1794587189, -795869184, 254052821, 1357122976, -1779633265, -564239360, 710429145, 2046514400, -848757741, 616792064, -2144473827, -540271072, 1136836183, -1405662208, 424680097, -1959504544, 34341211, 2113929216, -12971675, -2048600416, 304862239, -1539607552, 1010894953, -630534688, 2129128867, 703102976, -610431315, -1808197856, 1408109799, 451959808, -378213583, -1078878624, -1646438165, -2077229056, 1927445749, 1781448608, 1783611567, 1937867776, -2046747911, -1576229152, -941401293, -138051584, 838104125, 1991421984, -968636553, 552365056, -2030932031, -123943072, 1983089787, 0, -1773368187, 962906272, -376080065, -1490250752, 1920549257, 1271652320, 863372483, 701136896, 790453709, 1136912672, 1746185735, -1670939648, -518690735, 913887328, -1662166005, 349175808, -1635844075, 978973088, -389956145, -1441225728, 2126658585, 1730377952, 1671604819, 1957134336, -1701115043, -706231776, 653885591, -1908569088, 203592929, -1592215200, 1301383067, 301989888, -287795291, -460244320, -207532449, 478262272, 1605159593, -1113689632, 919866339, -875790336, 2097691885, 1258896160, 911408935, 1063951360, 1725347185, -1390443936, 315543339, -1737490432, 1049629493, 96314272, -293016849, -108805120, 658615609, 2019019488, -312678029, -2031517696, 1167569533, 704861216, 885647799, 1720364032, -1075410431, 1098918752, -335809861, -1073741824, -1103875387, -415093600, 1003836287, -1130703872, 1782686665, 1165657056, 1324876547, -2022801408, -275502067, -2011099872, 1372520519, 1297726464, 2071909009, -587352992, 1922544203, 1024458752, 1026274901, 1941034400, -513062897, -2027756544, 1705340505, 2109840608, -800581485, 1577811968, 669018525, 782067232, 1931150039, -164377600, -1195094239, -1146413728, -3617317, -2046820352, 1328897509, 1548721824, -1372092257, 1171780608, 605932777, 1240995296, -1202197981, 1882226688, 1920412461, -1071423712, 1513009511, 1100274688, 2001977265, -60070304, -773978773, -122683392, 1911023989, 1049528224, 1605293359, -699005952, -1550614663, -931598624, 1176123315, 495812608, 1340813501, -565315552, -908932105, 328788992, -1128143807, -965636256, 835590395, },
-        { 0, 5, 160, 1215, 5120, 15625, 38880, 84035, 163840, 295245, 500000, 805255, 1244160, 1856465, 2689120, 3796875, 5242880, 7099285, 9447840, 12380495, 16000000, 20420505, 25768160, 32181715, 39813120, 48828125, 59406880, 71744535, 86051840, 102555745, 121500000, 143145755, 167772160, 195676965, 227177120, 262609375, 302330880, 346719785, 396175840, 451120995, 512000000, 579281005, 653456160, 735042215, 824581120, 922640625, 1029814880, 1146725035, 1274019840, 1412376245, 1562500000, 1725126255, 1901020160, 2090977465, -1999142176, -1778545421, -1541308416, -1286507011, -1013183456, -720345801, -406967296, -71985791, 285696864, 667215419, 1073741824, 1506485829, 1966695584, -1839309057, -1320266752, -769777847, -186434592, 431212163, 1084653568, 1775423373, -1789868768, -1019667513, -207275008, 649018897, 1550969952, -1794587189, -795869184, 254052821, 1357122976, -1779633265, -564239360, 710429145, 2046514400, -848757741, 616792064, -2144473827, -540271072, 1136836183, -1405662208, 424680097, -1959504544, 34341211, 2113929216, -12971675, -2048600416, 304862239, -1539607552, 1010894953, -630534688, 2129128867, 703102976, -610431315, -1808197856, 1408109799, 451959808, -378213583, -1078878624, -1646438165, -2077229056, 1927445749, 1781448608, 1783611567, 1937867776, -2046747911, -1576229152, -941401293, -138051584, 838104125, 1991421984, -968636553, 552365056, -2030932031, -123943072, 1983089787, 0, -1773368187, 962906272, -376080065, -1490250752, 1920549257, 1271652320, 863372483, 701136896, 790453709, 1136912672, 1746185735, -1670939648, -518690735, 913887328, -1662166005, 349175808, -1635844075, 978973088, -389956145, -1441225728, 2126658585, 1730377952, 1671604819, 1957134336, -1701115043, -706231776, 653885591, -1908569088, 203592929, -1592215200, 1301383067, 301989888, -287795291, -460244320, -207532449, 478262272, 1605159593, -1113689632, 919866339, -875790336, 2097691885, 1258896160, 911408935, 1063951360, 1725347185, -1390443936, 315543339, -1737490432, 1049629493, 96314272, -293016849, -108805120, 658615609, 2019019488, -312678029, -2031517696, 1167569533, 704861216, 885647799, 1720364032, -1075410431, 1098918752, -335809861, -1073741824, -1103875387, -415093600, 1003836287, -1130703872, 1782686665, 1165657056, 1324876547, -2022801408, -275502067, -2011099872, 1372520519, 1297726464, 2071909009, -587352992, 1922544203, 1024458752, 1026274901, 1941034400, -513062897, -2027756544, 1705340505, 2109840608, -800581485, 1577811968, 669018525, 782067232, 1931150039, -164377600, -1195094239, -1146413728, -3617317, -2046820352, 1328897509, 1548721824, -1372092257, 1171780608, 605932777, 1240995296, -1202197981, 1882226688, 1920412461, -1071423712, 1513009511, 1100274688, 2001977265, -60070304, -773978773, -122683392, 1911023989, 1049528224, 1605293359, -699005952, -1550614663, -931598624, 1176123315, 495812608, 1340813501, -565315552, -908932105, 328788992, -1128143807, -965636256, 835590395, },
-        { 0, 9, 288, 2187, 9216, 28125, 69984, 151263, 294912, 531441, 900000, 1449459, 2239488, 3341637, 4840416, 6834375, 9437184, 12778713, 17006112, 22284891, 28800000, 36756909, 46382688, 57927087, 71663616, 87890625, 106932384, 129140163, 154893312, 184600341, 218700000, 257662359, 301989888, 352218537, 408918816, 472696875, 544195584, 624095613, 713116512, 812017791, 921600000, 1042705809, 1176221088, 1323075987, 1484246016, 1660753125, 1853666784, 2064105063, -2001731584, -1752690055, -1482467296, -1189740037, -873131008, -531207859, -162482080, 234592079, 661618688, 1120261217, 1612243616, 2139351395, -1591534592, -988567883, -344739104, 341994295, 1073741824, 1852681033, -1613908704, -733775925, 200500224, 1191380253, -2053569184, -941805025, 234389504, 1477775153, -1503776864, -117414605, 1344891904, -1408746363, 214765536, 1923703815, -573571072, 1316288537, -993152480, 1091627419, -1015630848, 1278772461, -611241376, 1908209903, 251232256, -1283072511, 1604492448, 328318211, -812205056, -1812556203, 1626852576, 920807639, 369098752, -23349015, -251506912, -310241429, -194313216, 101623997, 583024480, 1255451583, 2124578816, -1098776367, 181217696, 1675604179, -904459264, 1037202469, -1082988064, 1331378599, -303038464, -1684558407, 1488620576, 633520443, 52188160, -248172403, -260232096, 23464591, 610500608, 1508587425, -1569401184, -25558877, 1853250560, -219703819, -1941084448, 992581239, 0, -615082359, -843749088, -676944117, -105470976, 880008285, -2005993120, -163916449, 2121039872, 563823217, -530537568, -1151832973, -1289704448, -933643323, -72989728, 1303068487, -1089470464, 1350447961, 44164640, -701921061, -876219392, -466981843, 537699936, -2145072081, 86867968, -1344020159, -2130210656, 2035987523, -1717437440, -492526187, 1428979936, -234490857, -1174405120, -1377024983, -828439776, 485435051, -1716108288, 1171300349, 572339040, 796765951, 1859551232, -519121903, -2028954208, 1640536083, 1915112448, -1189342363, 933174752, -291015449, -550502400, 171346169, 1891352608, 331563131, -195849216, 326514637, 1916248160, 296173007, -220758016, 383638241, 2127743648, 735172579, 519674880, 1500235061, -598926624, -1463451209, -1073741824, 590004681, -747168480, -770075061, 541713408, -1086131299, -1337791136, -192202593, -1923055616, 2081076657, -1042999392, 1611543475, 1476914176, -1424524539, 1519744992, 1742592647, -732954624, -1588679015, -801105376, 1653467163, 1503998976, -1225354387, 2079726176, -1441046673, 1122074624, 1204233345, -1169259360, -1677890685, -295879680, -1292176171, -345557792, -1724498089, -1107296256, 1533022057, 1928705824, 107214315, 391218176, -1486301379, -1202182304, 1272017471, 1670021120, 20768593, 648417696, -712556717, 262507520, -691408219, 750866912, 324825127, -1938817024, -1714117575, 1030157344, 2030534587, 1318769664, -1073119475, -817884064, 2117021967, -825524224, -1022509535, 1559412384, -1636077789, -1985160192, 546321525, 1697828576, 1504062711, },
-        { 0, 7, 224, 1701, 7168, 21875, 54432, 117649, 229376, 413343, 700000, 1127357, 1741824, 2599051, 3764768, 5315625, 7340032, 9938999, 13226976, 17332693, 22400000, 28588707, 36075424, 45054401, 55738368, 68359375, 83169632, 100442349, 120472576, 143578043, 170100000, 200404057, 234881024, 273947751, 318047968, 367653125, 423263232, 485407699, 554646176, 631569393, 716800000, 810993407, 914838624, 1029059101, 1154413568, 1291696875, 1441740832, 1605415049, 1783627776, 1977326743, -2107467296, -1879790539, -1633539072, -1367598845, -1080812128, -771976671, -439844864, -83122897, 299530080, 709502797, 1148232704, 1617206811, 2117962528, -1642878791, -1073741824, -467900217, 176393440, 860941157, 1587600384, -1936682445, -1120001888, -255296431, 659521536, 1626599263, -1646822816, -568541059, 568808448, 1767619915, -1264615904, 64558313, 1462763520, -1362312969, 181985248, 1803480725, -789935104, 994600803, -1429847136, 529726081, -1713471488, 433710479, -1615372960, 732577197, -1108933632, 1453545595, -166325984, -1669909223, 1241513984, -18160345, -1150053664, 2144794053, 1280523264, 556259475, -23755104, -455193423, -733642752, -854603841, -813490080, -605626659, -226249728, 329494443, 1066550304, 1989953865, -1190133760, 121443671, 1635034592, -938917643, 995027968, -1147460157, 1229253024, -458968351, -1911259136, 1173345775, 211010400, -497097715, -944675840, -1125317925, -1032513760, -659648135, 0, 953258375, -2087905056, -526512091, 1349622784, -747204877, 1780313248, 349728017, -736395264, -1470345185, -1844296096, -1850307267, -1480322048, -726167029, 420448800, 1967934889, -370147328, 2004785591, 511568864, -545938603, -1158722560, -1317645277, -1013444704, -236733631, 1022001152, -1522567601, 729262432, -802547091, -1813003264, 2003017019, 2065866016, -1614037543, -436207616, 1315073511, -644342048, -2008532347, 1528560640, 1388229971, 1876808352, -1289167503, 491880448, -1358198657, 1762454624, 1275972509, 1489531904, -1879481237, -228634592, -2135219703, 1003487232, 610487831, 993833440, -2128210507, -152327168, -1654918525, 1967633824, 2139231137, -1126137856, 775603887, -731181216, -1337073459, -1027464192, 212412315, -1897487584, 1247853113, 1073741824, 1890548295, -581131040, -2030603035, 1852988416, -1799205965, -86067040, -1581146671, -1972928512, -1244696353, 620434016, -655451651, -760163328, 323692235, -1681287648, 1832568425, -2001731584, -281202057, -1577519136, -1577281515, -261878784, -1907490589, 2094783392, -1120814079, 1349943296, 936625935, 1953887584, 126629677, -230128640, 903848443, -745985760, -864057703, 570425344, -716523865, -408769824, 1515044677, 781499392, 1707299347, 19406496, 34909745, 1776123904, 970590527, 1935980640, 400226397, 681391104, -1492199125, -1802085344, -224576823, -1030750208, 98453207, -1107640864, -329569675, -1837601792, -1311867069, 1272742304, 1646572641, -164855808, 159151983, -1650435232, -1272504947, 1319298048, 1856572507, 366096160, 1169826553, },
-        { 0, 5, 160, 1215, 5120, 15625, 38880, 84035, 163840, 295245, 500000, 805255, 1244160, 1856465, 2689120, 3796875, 5242880, 7099285, 9447840, 12380495, 16000000, 20420505, 25768160, 32181715, 39813120, 48828125, 59406880, 71744535, 86051840, 102555745, 121500000, 143145755, 167772160, 195676965, 227177120, 262609375, 302330880, 346719785, 396175840, 451120995, 512000000, 579281005, 653456160, 735042215, 824581120, 922640625, 1029814880, 1146725035, 1274019840, 1412376245, 1562500000, 1725126255, 1901020160, 2090977465, -1999142176, -1778545421, -1541308416, -1286507011, -1013183456, -720345801, -406967296, -71985791, 285696864, 667215419, 1073741824, 1506485829, 1966695584, -1839309057, -1320266752, -769777847, -186434592, 431212163, 1084653568, 1775423373, -1789868768, -1019667513, -207275008, 649018897, 1550969952, -1794587189, -795869184, 254052821, 1357122976, -1779633265, -564239360, 710429145, 2046514400, -848757741, 616792064, -2144473827, -540271072, 1136836183, -1405662208, 424680097, -1959504544, 34341211, 2113929216, -12971675, -2048600416, 304862239, -1539607552, 1010894953, -630534688, 2129128867, 703102976, -610431315, -1808197856, 1408109799, 451959808, -378213583, -1078878624, -1646438165, -2077229056, 1927445749, 1781448608, 1783611567, 1937867776, -2046747911, -1576229152, -941401293, -138051584, 838104125, 1991421984, -968636553, 552365056, -2030932031, -123943072, 1983089787, 0, -1773368187, 962906272, -376080065, -1490250752, 1920549257, 1271652320, 863372483, 701136896, 790453709, 1136912672, 1746185735, -1670939648, -518690735, 913887328, -1662166005, 349175808, -1635844075, 978973088, -389956145, -1441225728, 2126658585, 1730377952, 1671604819, 1957134336, -1701115043, -706231776, 653885591, -1908569088, 203592929, -1592215200, 1301383067, 301989888, -287795291, -460244320, -207532449, 478262272, 1605159593, -1113689632, 919866339, -875790336, 2097691885, 1258896160, 911408935, 1063951360, 1725347185, -1390443936, 315543339, -1737490432, 1049629493, 96314272, -293016849, -108805120, 658615609, 2019019488, -312678029, -2031517696, 1167569533, 704861216, 885647799, 1720364032, -1075410431, 1098918752, -335809861, -1073741824, -1103875387, -415093600, 1003836287, -1130703872, 1782686665, 1165657056, 1324876547, -2022801408, -275502067, -2011099872, 1372520519, 1297726464, 2071909009, -587352992, 1922544203, 1024458752, 1026274901, 1941034400, -513062897, -2027756544, 1705340505, 2109840608, -800581485, 1577811968, 669018525, 782067232, 1931150039, -164377600, -1195094239, -1146413728, -3617317, -2046820352, 1328897509, 1548721824, -1372092257, 1171780608, 605932777, 1240995296, -1202197981, 1882226688, 1920412461, -1071423712, 1513009511, 1100274688, 2001977265, -60070304, -773978773, -122683392, 1911023989, 1049528224, 1605293359, -699005952, -1550614663, -931598624, 1176123315, 495812608, 1340813501, -565315552, -908932105, 328788992, -1128143807, -965636256, 835590395, }, 
-    }, {{ 0, 4, 256, 2916, 16384, 62500, 186624, 470596, 1048576, 2125764, 4000000, 7086244, 11943936, 19307236, 30118144, 45562500, 67108864, 96550276, 136048896, 188183524, 256000000, 343064484, 453519616, 592143556, 764411904, 976562500, 1235663104, 1549681956, 1927561216, -1915674012, -1378967296, -744952572, 0, 870904580, 1884250368, -1236872092, 117194752, 1672971044, -841156352, 1190073156, -795869184, 1820547780, 481290496, -484351580, -1039515648, -1144675868, -757518080, 167188356, 1677721600, -469426044, -1924509440, 1665674468, 1773027328, -1536868700, 395397376, -946587196, -1190133760, -253164476, 1950914816, 1218410020, 1940406272, -76932764, -432324352, 985905668, 0, 1027851780, -96681728, 1056275812, 332939264, -2119044572, -1850402560, 1300027460, -1089470464, -253483580, -304035584, -1050508636, 2000568320, 465864932, -1144729344, 1687213188, 603979776, 141747076, 550940928, 2091435492, 737820672, 1064541604, -933730048, -661983548, -2104492032, -644694204, -244811520, -560691420, -1236516864, -1904545692, 2110120192, -1685035260, 0, -1006601980, 21504256, -765720988, 1385447424, -1642053340, -771016448, 205552964, 1804599296, 263377092, 424651008, -1442872412, -464371712, -338472988, -452038400, -174820988, 1140850688, -134576508, 977342720, 883506916, 304496640, -20063068, 668829952, -1145076796, -368050176, -475899324, -628729600, 34437156, -1898954752, -1229740188, -1326546688, -1240534012, 0, -904983548, 1358004480, -758485148, -1892663296, -952995804, -1117824768, -1245052348, -166723584, -983606332, 1820100864, 902325412, 1833320448, 1621227236, 1597378816, -1173229948, -1006632960, -779351676, 956920064, 1385797604, 2016559104, 94632868, 1486924032, -792594236, -812646400, -1199057596, -249415424, -522565340, -248233984, -1916518812, 607461632, 609181956, 0, 727678724, 481878272, 1284552804, 900481024, 1427668772, 707885312, 917071684, -24117248, 140101316, -588814080, 126690724, 370819072, -1730118172, 582725888, 1226394500, -1543503872, -837325692, 1689243904, 130666724, 1511931904, 19266212, -1524512512, -249410108, -1827667968, 1001599044, -1631840000, 1925904932, 1903706112, 1465693540, -468074240, -631132668, 0, 501338628, 1982720, 1979638116, 1376272384, 1778544164, -1761502976, -1251038140, -1525678080, 1225920964, -2012198656, 1277019812, -2100412416, 490661092, 270487808, 1404733572, -469762048, -1064521852, -323735296, 1871309284, 1407860736, -1467754076, 2145446144, -261061948, 344981504, 177498948, -187434752, -105936092, 1134313472, 19729508, 1696358656, -1504322812, 0, -1316616956, -22961920, 795142756, -1874575360, 1914715428, 709867776, 313119044, -1987051520, -235389756, -1284036352, 977946532, -144556032, 1617767396, -270470912, 621127044, -2080374784, -1780755836, -392785664, 254403300, -1583988736, 1022204068, -2090989312, 473733060, -1274019840, -56916412, -1393960704, -2124940252, 1000357888, -1562033308, -2084765440, -1338251260, },
-        { 0, 2, 128, 1458, 8192, 31250, 93312, 235298, 524288, 1062882, 2000000, 3543122, 5971968, 9653618, 15059072, 22781250, 33554432, 48275138, 68024448, 94091762, 128000000, 171532242, 226759808, 296071778, 382205952, 488281250, 617831552, 774840978, 963780608, 1189646642, 1458000000, 1775007362, -2147483648, -1712031358, -1205358464, -618436046, 58597376, 836485522, 1726905472, -1552447070, -397934592, 910273890, -1906838400, -242175790, 1627725824, -572337934, 1768724608, 83594178, -1308622848, 1912770626, 1185228928, 832837234, 886513664, 1379049298, -1949784960, -473293598, 1552416768, -126582238, -1172026240, -1538278638, -1177280512, -38466382, 1931321472, 492952834, 0, 513925890, 2099142784, 528137906, 166469632, 1087961362, -925201280, -1497469918, -544735232, 2020741858, 1995465856, -525254318, -1147199488, 232932466, -572364672, 843606594, 301989888, -2076610110, -1872013184, 1045717746, -1778573312, -1615212846, 1680618624, -330991774, 1095237632, 1825136546, 2025077888, 1867137938, 1529225216, 1195210802, 1055060096, 1304966018, -2147483648, -503300990, -2136731520, 1764623154, -1454759936, 1326456978, 1761975424, 102776482, 902299648, 131688546, -1935158144, -721436206, -232185856, -169236494, -226019200, -87410494, 570425344, 2080195394, 488671360, 441753458, -1995235328, 2137452114, 334414976, 1574945250, 1963458560, 1909533986, 1833118848, -2130265070, -949477376, 1532613554, 1484210304, -620267006, 0, -452491774, -1468481408, 1768241074, 1201152000, 1670985746, -558912384, -622526174, 2064121856, -491803166, 910050432, -1696320942, 916660224, 810613618, -1348794240, -586614974, -503316480, -389675838, 478460032, -1454584846, -1139204096, -2100167214, 743462016, -396297118, -406323200, 1547954850, 2022775936, 1886200978, 2023366656, -958259406, -1843752832, 304590978, -2147483648, 363839362, 240939136, -1505207246, 450240512, -1433649262, -1793540992, 458535842, 2135425024, 70050658, -294407040, -2084138286, 185409536, -865059086, 291362944, 613197250, 1375731712, -418662846, 844621952, -2082150286, 755965952, -2137850542, -762256256, 2022778594, -913833984, 500799522, -815920000, 962952466, -1195630592, -1414636878, 1913446528, 1831917314, 0, -1896814334, -2146492288, 989819058, 688136192, -1258211566, 1266732160, 1521964578, 1384644608, -1534523166, -1006099328, 638509906, 1097277440, -1902153102, -2012239744, -1445116862, 1912602624, 1615222722, -161867648, -1211829006, 703930368, -733877038, 1072723072, -130530974, -1974992896, -2058734174, 2053766272, -52968046, -1580326912, 9864754, -1299304320, 1395322242, -2147483648, -658308478, -11480960, -1749912270, 1210195968, -1190125934, -1792549760, -1990924126, 1153957888, 2029788770, -642018176, 488973266, -72278016, 808883698, 2012248192, -1836920126, 1107296256, 1257105730, 1951090816, -2020281998, 1355489280, -1636381614, 1101988992, 236866530, -637009920, 2119025442, -696980352, -1062470126, 500178944, -781016654, -1042382720, -669125630, },
-        { 0, 6, 384, 4374, 24576, 93750, 279936, 705894, 1572864, 3188646, 6000000, 10629366, 17915904, 28960854, 45177216, 68343750, 100663296, 144825414, 204073344, 282275286, 384000000, 514596726, 680279424, 888215334, 1146617856, 1464843750, 1853494656, -1970444362, -1403625472, -726027370, 79032704, 1030054790, -2147483648, -841126778, 678891904, -1855308138, 175792128, -1785510730, 885749120, -362373914, -1193803776, -1564145626, -1425547904, -726527370, 588210176, -1717013802, 1011206528, 250782534, 369098752, 1443344582, -739280512, -1796455594, -1635426304, -157819402, -1554387584, -1419880794, 362283008, -379746714, 778888576, -319868618, 763125760, -115399146, 1498997120, 1478858502, 0, 1541777670, 2002461056, 1584413718, 499408896, -1031083210, 1519363456, -197442458, -1634205696, 1767258278, 1691430272, -1575762954, 853368832, 698797398, -1717094016, -1764147514, 905969664, -1934863034, -1321072256, -1157814058, -1040752640, -550671242, 746888576, -992975322, -1009254400, 1180442342, 1780266368, 1306446518, 292708352, -709334890, -1129787008, -380069242, -2147483648, -1509902970, -2115227264, 998902166, -69312512, -315596362, 990958976, 308329446, -1588068352, 395065638, -1510507136, 2130658678, -696557568, -507709482, -678057600, -262231482, 1711276032, 1945618886, 1466014080, 1325260374, -1690738688, 2117389046, 1003244928, 429868454, 1595408384, 1433634662, 1204389248, -2095827914, 1446535168, 302873366, 157663616, -1860801018, 0, -1357475322, -110476928, 1009755926, -691511296, 717989942, -1676737152, -1867578522, 1897398272, -1475409498, -1564816000, -793995530, -1544986624, -1863126442, 248584576, -1759844922, -1509949440, -1169027514, 1435380096, -68787242, 877355008, -2005534346, -2064581248, -1188891354, -1218969600, 348897254, 1773360512, 1363635638, 1775132672, 1420189078, -1236291200, 913772934, -2147483648, 1091518086, 722817408, -220654442, 1350721536, -5980490, -1085655680, 1375607526, 2111307776, 210151974, -883221120, -1957447562, 556228608, 1699790038, 874088832, 1839591750, -167772160, -1255988538, -1761101440, -1951483562, -2027069440, -2118584330, 2008198528, 1773368486, 1553465344, 1502398566, 1847207296, -1406109898, 708075520, 51056662, 1445372288, 1200784646, 0, -1395475706, -2144509568, -1325510122, 2064408576, 520332598, -494770816, 270926438, -141033472, -308602202, 1276669312, 1915529718, -1003134976, -1411492010, -1741751936, -40383290, 1442840576, 550700870, -485602944, 659480278, 2111791104, 2093336182, -1076798080, -391592922, -1630011392, -1881235226, 1866331520, -158904138, -446013440, 29594262, 397054336, -109000570, -2147483648, -1974925434, -34442880, -954769514, -664379392, 724589494, -1082681984, -1677805082, -833093632, 1794399014, -1926054528, 1466919798, -216834048, -1868316202, 1741777280, -1215793082, -973078528, -523650106, 1558305152, -1765878698, -228499456, -614177546, -989000320, 710599590, -1911029760, 2062109030, -2090941056, 1107556918, 1500536832, 1951917334, 1167819136, -2007376890, },
-        { 0, 4, 256, 2916, 16384, 62500, 186624, 470596, 1048576, 2125764, 4000000, 7086244, 11943936, 19307236, 30118144, 45562500, 67108864, 96550276, 136048896, 188183524, 256000000, 343064484, 453519616, 592143556, 764411904, 976562500, 1235663104, 1549681956, 1927561216, -1915674012, -1378967296, -744952572, 0, 870904580, 1884250368, -1236872092, 117194752, 1672971044, -841156352, 1190073156, -795869184, 1820547780, 481290496, -484351580, -1039515648, -1144675868, -757518080, 167188356, 1677721600, -469426044, -1924509440, 1665674468, 1773027328, -1536868700, 395397376, -946587196, -1190133760, -253164476, 1950914816, 1218410020, 1940406272, -76932764, -432324352, 985905668, 0, 1027851780, -96681728, 1056275812, 332939264, -2119044572, -1850402560, 1300027460, -1089470464, -253483580, -304035584, -1050508636, 2000568320, 465864932, -1144729344, 1687213188, 603979776, 141747076, 550940928, 2091435492, 737820672, 1064541604, -933730048, -661983548, -2104492032, -644694204, -244811520, -560691420, -1236516864, -1904545692, 2110120192, -1685035260, 0, -1006601980, 21504256, -765720988, 1385447424, -1642053340, -771016448, 205552964, 1804599296, 263377092, 424651008, -1442872412, -464371712, -338472988, -452038400, -174820988, 1140850688, -134576508, 977342720, 883506916, 304496640, -20063068, 668829952, -1145076796, -368050176, -475899324, -628729600, 34437156, -1898954752, -1229740188, -1326546688, -1240534012, 0, -904983548, 1358004480, -758485148, -1892663296, -952995804, -1117824768, -1245052348, -166723584, -983606332, 1820100864, 902325412, 1833320448, 1621227236, 1597378816, -1173229948, -1006632960, -779351676, 956920064, 1385797604, 2016559104, 94632868, 1486924032, -792594236, -812646400, -1199057596, -249415424, -522565340, -248233984, -1916518812, 607461632, 609181956, 0, 727678724, 481878272, 1284552804, 900481024, 1427668772, 707885312, 917071684, -24117248, 140101316, -588814080, 126690724, 370819072, -1730118172, 582725888, 1226394500, -1543503872, -837325692, 1689243904, 130666724, 1511931904, 19266212, -1524512512, -249410108, -1827667968, 1001599044, -1631840000, 1925904932, 1903706112, 1465693540, -468074240, -631132668, 0, 501338628, 1982720, 1979638116, 1376272384, 1778544164, -1761502976, -1251038140, -1525678080, 1225920964, -2012198656, 1277019812, -2100412416, 490661092, 270487808, 1404733572, -469762048, -1064521852, -323735296, 1871309284, 1407860736, -1467754076, 2145446144, -261061948, 344981504, 177498948, -187434752, -105936092, 1134313472, 19729508, 1696358656, -1504322812, 0, -1316616956, -22961920, 795142756, -1874575360, 1914715428, 709867776, 313119044, -1987051520, -235389756, -1284036352, 977946532, -144556032, 1617767396, -270470912, 621127044, -2080374784, -1780755836, -392785664, 254403300, -1583988736, 1022204068, -2090989312, 473733060, -1274019840, -56916412, -1393960704, -2124940252, 1000357888, -1562033308, -2084765440, -1338251260, },
-        { 0, 1, 64, 729, 4096, 15625, 46656, 117649, 262144, 531441, 1000000, 1771561, 2985984, 4826809, 7529536, 11390625, 16777216, 24137569, 34012224, 47045881, 64000000, 85766121, 113379904, 148035889, 191102976, 244140625, 308915776, 387420489, 481890304, 594823321, 729000000, 887503681, 1073741824, 1291467969, 1544804416, 1838265625, -2118184960, -1729240887, -1284030912, -776223535, -198967296, 455136945, 1194064448, 2026395753, -1333620736, -286168967, 884362304, -2105686559, -654311424, 956385313, -1554869184, 416418617, -1704226816, 689524649, -974892480, 1910836849, 776208384, -63291119, -586013120, -769139319, -588640256, -19233191, 965660736, -1901007231, 0, -1890520703, 1049571392, 264068953, 83234816, 543980681, 1684883008, -748734959, 1875116032, 1010370929, 997732928, 1884856489, -573599744, -2031017415, 1861301312, -1725680351, 150994944, -1038305055, -936006592, 522858873, -889286656, -807606423, 840309312, -165495887, 547618816, -1234915375, -1134944704, 933568969, 764612608, -1549878247, -1619953600, 652483009, 1073741824, -251650495, 1079117888, 882311577, -727379968, 663228489, 880987712, 51388241, -1696333824, 65844273, 1179904576, 1786765545, 2031390720, 2062865401, 2034474048, 2103778401, -1862270976, -1107385951, 244335680, -1926606919, 1149865984, 1068726057, -1980276160, 787472625, 981729280, -1192716655, -1230924224, 1082351113, 1672744960, 766306777, -1405378496, -310133503, 0, -226245887, -734240704, -1263363111, -1546907648, -1311990775, -279456192, 1836220561, 1032060928, 1901582065, 455025216, 1299323177, 458330112, -1742176839, -674397120, -293307487, -251658240, -194837919, 239230016, 1420191225, -569602048, -1050083607, 371731008, -198148559, 1944322048, -1373506223, -1136095680, -1204383159, -1135800320, -479129703, 1225607232, 152295489, 1073741824, 181919681, -2027014080, -752603623, 225120256, 1430659017, -896770496, -1918215727, -1079771136, -2112458319, -147203520, 1105414505, -2054778880, -432529543, -2001802176, -1840885023, 687865856, 1938152225, -1725172672, -1041075143, 377982976, -1068925271, -381128128, -1136094351, 1690566656, 250399761, -407960000, 481476233, -597815296, 1440165209, -1190760384, 915958657, 0, 1199076481, 1074237504, 494909529, 344068096, 1518377865, 633366080, -1386501359, 692322304, -767261583, -503049664, -1828228695, 548638720, -951076551, -1006119872, 1424925217, -1191182336, 807611361, -80933824, 1541569145, -1795518464, -366938519, -1611122112, -65265487, 1159987200, -1029367087, -1120600512, 2120999625, 1357320192, -2142551271, 1497831488, 697661121, 1073741824, -329154239, 2141743168, 1272527513, -1542385664, -595062967, 1251208768, 1152021585, 576978944, 1014894385, -321009088, -1902997015, 2111344640, 404441849, -1141359552, -918460063, -1593835520, -1518930783, 975545408, -1010140999, -1469739008, 1329292841, 550994496, -2029050383, -318504960, -1087970927, 1798993472, 1616248585, 250089472, -390508327, 1626292288, -334562815, },
-        { 0, 9, 576, 6561, 36864, 140625, 419904, 1058841, 2359296, 4782969, 9000000, 15944049, 26873856, 43441281, 67765824, 102515625, 150994944, 217238121, 306110016, 423412929, 576000000, 771895089, 1020419136, 1332323001, 1719926784, -2097701671, -1514725312, -808182895, 42045440, 1058442593, -2028934592, -602401463, 1073741824, -1261690167, 1018337856, -635478559, -1883795456, 1616701201, 1328623680, 1603922777, -1790705664, -198734791, -2138321856, 1057692593, 882315264, 1719446593, -630673856, -1771309847, -1593835520, 17533225, -1108920768, -547199743, 1841827840, 1910754545, -184097728, 17662457, -1604059136, -569620071, -979150784, 1667680721, -1002795008, -173098719, 101012032, 70804105, 0, 165182857, 856207936, -1918346719, 749113344, 600858833, -2015922112, 1851319961, -303824896, 503403769, 389661760, -216160783, -867430400, -1099287551, -428157376, 1648746025, 1358954496, -754810903, 165875264, 410762561, 586354688, 1321476785, -1027150784, -1489462983, 633602048, 1770663513, -1624567744, -187813871, -1708421120, -1064002335, -1694680512, 1577379785, 1073741824, 2030112841, 1122126400, -649130399, 2043514880, 1674089105, -661045184, 462494169, 1912864768, 592598457, 2029206592, -1098979279, 1102647296, 1385919425, 1130397248, 1754136425, 419430400, -1376538967, -2095946176, -159593087, 1758859264, 1028599921, -642616256, -1502680967, 245628928, -2144515303, 1806583872, 1151225425, -2125164544, -1693173599, 236495424, 1503765769, 0, -2036212983, 1981768256, 1514633889, -1037266944, 1076984913, 1779861568, -653884135, 698613760, -65630599, -199740352, -1190993295, -169996288, 1500277633, -1774606784, 1655199913, 2030043136, -1753541271, -2141897152, -103180863, -831451136, -860817871, -949388224, -1783337031, 319029248, 523345881, -1634926528, 2045453457, -1632268288, -17200031, -1854436800, 1370659401, 1073741824, 1637277129, -1063257536, 1816501985, 2026082304, -8970735, 519000128, -84072359, -1128005632, -1832255687, -1324831680, 1358795953, -1313140736, 402201409, -836350400, 611903977, 1895825408, 263500841, 1653315136, -779741695, -893120512, -1030392847, 864814144, -1634914567, -1964769280, -2041369447, 623327296, 38318801, -1085370368, 76584993, -2126908864, -346306679, 0, -2093213559, 1078202944, 159218465, -1198354432, 780498897, 1405327424, 406389657, 1935933440, 1684580345, -232479680, 725810929, 642781184, 30245633, -465144256, -60574935, -2130706432, -1321432343, -728404416, 989220417, 1020203008, 992520625, -1615197120, -587389383, 1849950208, -674369191, -1495470016, 1909127441, -669020160, -2103092255, 595581504, 1983982793, 1073741824, 1332579145, 2095819328, -1432154271, -996569088, -1060599407, -1624022976, 1778259673, 897843200, 544114873, 1405885504, 52896049, 1822232576, -654990655, -1682301376, 323794025, -1459617792, -785475159, 189974080, -501334399, -342749184, -921266319, 663983168, -1081584263, 1428422656, -1201803751, -988927936, 1661335377, -2044162048, 780392353, 1751728704, 1283901961, },
-        { 0, 1, 64, 729, 4096, 15625, 46656, 117649, 262144, 531441, 1000000, 1771561, 2985984, 4826809, 7529536, 11390625, 16777216, 24137569, 34012224, 47045881, 64000000, 85766121, 113379904, 148035889, 191102976, 244140625, 308915776, 387420489, 481890304, 594823321, 729000000, 887503681, 1073741824, 1291467969, 1544804416, 1838265625, -2118184960, -1729240887, -1284030912, -776223535, -198967296, 455136945, 1194064448, 2026395753, -1333620736, -286168967, 884362304, -2105686559, -654311424, 956385313, -1554869184, 416418617, -1704226816, 689524649, -974892480, 1910836849, 776208384, -63291119, -586013120, -769139319, -588640256, -19233191, 965660736, -1901007231, 0, -1890520703, 1049571392, 264068953, 83234816, 543980681, 1684883008, -748734959, 1875116032, 1010370929, 997732928, 1884856489, -573599744, -2031017415, 1861301312, -1725680351, 150994944, -1038305055, -936006592, 522858873, -889286656, -807606423, 840309312, -165495887, 547618816, -1234915375, -1134944704, 933568969, 764612608, -1549878247, -1619953600, 652483009, 1073741824, -251650495, 1079117888, 882311577, -727379968, 663228489, 880987712, 51388241, -1696333824, 65844273, 1179904576, 1786765545, 2031390720, 2062865401, 2034474048, 2103778401, -1862270976, -1107385951, 244335680, -1926606919, 1149865984, 1068726057, -1980276160, 787472625, 981729280, -1192716655, -1230924224, 1082351113, 1672744960, 766306777, -1405378496, -310133503, 0, -226245887, -734240704, -1263363111, -1546907648, -1311990775, -279456192, 1836220561, 1032060928, 1901582065, 455025216, 1299323177, 458330112, -1742176839, -674397120, -293307487, -251658240, -194837919, 239230016, 1420191225, -569602048, -1050083607, 371731008, -198148559, 1944322048, -1373506223, -1136095680, -1204383159, -1135800320, -479129703, 1225607232, 152295489, 1073741824, 181919681, -2027014080, -752603623, 225120256, 1430659017, -896770496, -1918215727, -1079771136, -2112458319, -147203520, 1105414505, -2054778880, -432529543, -2001802176, -1840885023, 687865856, 1938152225, -1725172672, -1041075143, 377982976, -1068925271, -381128128, -1136094351, 1690566656, 250399761, -407960000, 481476233, -597815296, 1440165209, -1190760384, 915958657, 0, 1199076481, 1074237504, 494909529, 344068096, 1518377865, 633366080, -1386501359, 692322304, -767261583, -503049664, -1828228695, 548638720, -951076551, -1006119872, 1424925217, -1191182336, 807611361, -80933824, 1541569145, -1795518464, -366938519, -1611122112, -65265487, 1159987200, -1029367087, -1120600512, 2120999625, 1357320192, -2142551271, 1497831488, 697661121, 1073741824, -329154239, 2141743168, 1272527513, -1542385664, -595062967, 1251208768, 1152021585, 576978944, 1014894385, -321009088, -1902997015, 2111344640, 404441849, -1141359552, -918460063, -1593835520, -1518930783, 975545408, -1010140999, -1469739008, 1329292841, 550994496, -2029050383, -318504960, -1087970927, 1798993472, 1616248585, 250089472, -390508327, 1626292288, -334562815, },
-    }, {{ 0, 3, 384, 6561, 49152, 234375, 839808, 2470629, 6291456, 14348907, 30000000, 58461513, 107495424, 188245551, 316240512, 512578125, 805306368, 1231016019, 1836660096, -1613352079, -454967296, 1108298327, -1106860928, 1624541749, 874512384, 1130677691, -1674373248, 1316288537, 1824079872, 210021375, 1185490560, 933463709, 0, -993689949, -1343739520, -255637695, -1130708992, 1327789863, -350635904, -623840379, 1893728256, 147269387, 128265088, -587952919, 55721984, 21895119, 1782913664, -549061395, 268435456, -1145279757, -1302143616, -712461039, 428589056, -2034730505, 981208192, 1755467477, 1553989632, 2062120539, 1112932224, 1301294009, 1418936320, 775293343, -775729536, 1486886205, 0, 715650371, 1656705408, 1538252001, -199966720, 934851271, 1638113408, -566756315, 1298137088, -2067065941, -1841589376, -1109052279, -1931722752, -1013587601, 1752810112, -964350067, 1879048192, 1094942099, 1670612352, 1342840497, -761937920, 218792343, 2051437696, -244753547, -1457520640, 990076667, -1492392064, 1461258073, 579682304, 1375665983, -1560381824, 1274063837, 0, -215850013, -566920832, 53533313, 829341696, -905230745, -1000699776, -1300902715, -975175680, -733890485, 1547500416, -1973877719, 1040596992, 247120655, 1361537664, 478538285, 1342177280, -1741682637, 1958423936, 1040543825, 721403904, 1460691255, -938091392, 1954852885, 1235222528, 835551131, 453300096, -44397831, -509132800, -397767457, 1342873216, 2098219645, 0, -1657812349, 1408934272, 1714503713, 1604894720, 501690887, -672239488, 639984997, 174063616, -133819157, -598121600, 651885513, -774881280, 1793572015, 469635712, -1274860339, -1342177280, 1144851155, 1703531904, -760894991, 499761152, -1235937065, -224770944, 433015989, 1847590912, 920836155, -890194048, -1692420455, 1021394944, 1963176575, 1117243008, -369495779, 0, 1967860003, -1581332096, 1344015809, -909983744, -493390425, 84891776, 1046595077, 1256194048, -1569511029, -2059351168, 141957993, 591020032, -1144533425, -1263682944, -96995475, -1879048192, -1633319565, -2119205504, -711603311, -2047623168, -605837193, -1937527680, -945540779, 1184890880, 1532913883, -8413312, -474772935, 2134589440, 529887263, -128586112, 858300349, 0, -1519419453, -1858997888, 1759265633, 448577536, -286846649, -1737670528, 1187376805, -1218445312, 1197733419, 94581632, -994745591, 759447552, -796526609, 988177024, 115296781, -268435456, -433817581, 551298432, 855692593, 511557632, 1749487639, 746722432, 853433845, 52428800, -103075461, 1566672768, 1927349721, -1816838144, 1122682303, 1123358336, -1416145315, 0, 1159188067, 402921856, -992157439, 1570160640, -786365209, 45623424, -512958651, 2145386496, 741571275, -2010080384, -1583099223, 183386112, -204654193, 1113066112, -1405868883, -805306368, 1324671667, -423637632, -1953380655, -2107129856, 2072661943, -1387955072, -287780203, -744488960, -965463525, 625373056, 1559439737, 89079808, -43076769, -2010825088, 1757484285, },
-        { 0, 1, 128, 2187, 16384, 78125, 279936, 823543, 2097152, 4782969, 10000000, 19487171, 35831808, 62748517, 105413504, 170859375, 268435456, 410338673, 612220032, 893871739, 1280000000, 1801088541, -1800609408, -890141849, 291504128, 1808548329, -558124416, 1870418611, 608026624, 70007125, 395163520, 1742810335, 0, -331229983, 983742592, -85212565, 1054752768, 442596621, -1548534400, -207946793, 631242752, 1480745561, -1388900736, 1235671459, 1450229760, 7298373, 2025960320, -183020465, -1342177280, -381759919, -434047872, -237487013, 1574518784, -2109899267, -1104586368, 2016811591, 517996544, 687373513, 370977408, 1865420435, -958676992, -1173224651, -258576512, 495628735, 0, 1670205889, 552235136, 512750667, 1365000192, -1120038675, 1977693568, -1620574537, 1864368128, 742633785, 817792640, -369684093, -643907584, -1769518299, -847385728, 1110205743, -805306368, 1796636465, 556870784, 447613499, -1685635072, 72930781, -747843200, -1513240281, 945815552, 1761681321, 934191744, -944569741, 1624883200, 1890211093, -1951783040, 1856343711, 0, 1359705761, -1620629376, 1449500203, 276447232, -1733399347, -333566592, 998021527, -325058560, -1676285927, 515833472, -2089615005, 346865664, 1514029317, 453845888, 1591168527, 1879048192, -580560879, 2084463744, 1778503707, 240467968, 486897085, -1744352896, -780038137, 1843396608, 1710172809, 151100032, -14799277, 1261944832, 1299066613, -984031360, -732249217, 0, 879051649, -962011008, 2003157003, 1966620672, 1598886061, 1207575936, -1218327433, -1373634560, -1476262151, -1631029632, 217295171, -258293760, -833798427, -1275110528, 1006702319, -1879048192, 1813272817, 567843968, -1685287429, 1598242816, -1843634787, -74923648, 144338663, -815792128, 306945385, 1134924416, -1995795917, -1091190784, 2086047957, 372414336, -1554821025, 0, -775702431, -1958766464, 1879661035, -1734983680, -164463475, 1459953024, 1780520791, -1012924416, -523170343, 745205376, 47319331, -1234649088, -1813166907, -421227648, -32331825, 805306368, -544439855, -2138057600, -1668856869, -682541056, -201945731, -645842560, -1746836025, 1826619392, -920684471, 1428851328, -158257645, -720125952, 1608284853, 1388793728, -1145555649, 0, -506473151, -2051321728, 2018077643, -1282129920, -1527271315, 852432256, -1035863497, 1025507328, 399244473, 1463182976, -1763237629, 253149184, -1697164635, -1102263424, -1393223505, 1342177280, 1287049905, 183766144, -1146424901, 1602174976, -848493219, -1182748288, -1147177817, 1449132032, -34358487, 522224256, 642449907, -2037268480, -1057428331, 1806108544, 959607327, 0, -1045259743, -1297348480, 1100936619, 523386880, 1169534029, 15207808, -170986217, 715128832, 247190425, -2101682560, -527699741, 61128704, 1363437701, -1060633728, -468622961, -268435456, -990098543, -141212544, -651126885, -2134032384, -740768451, -1894307456, 1335729031, -1679818752, -321821175, -1223198080, 1951469011, -1401962496, -14358923, 761380736, 585828095, },
-        { 0, 7, 896, 15309, 114688, 546875, 1959552, 5764801, 14680064, 33480783, 70000000, 136410197, 250822656, 439239619, 737894528, 1196015625, 1879048192, -1422596585, -9427072, 1962134877, 370065408, -277282101, 280636032, -1936025647, 2040528896, -225063585, 388096384, 208028389, -38780928, 490049875, -1528822656, -685229543, 0, 1976357415, -1703736448, -596487955, -1206665216, -1196790949, 2045161088, -1455627551, 123731968, 1775284335, -1132370560, 59765621, 1561673728, 51088611, 1296820352, -1281143255, -805306368, 1622647863, 1256632192, -1662409091, -1863270400, -1884392981, 857830016, 1232779249, -668991488, 516647295, -1698125440, 173041157, 1879195648, 377362035, -1810035584, -825566151, 0, -1193460665, -429321344, -705712627, 965066752, 749663867, 958953088, 1540880129, 165675008, 903469199, 1429581184, 1707178645, -212385792, 498273795, -1636732800, -818494391, -1342177280, -308446633, -396871808, -1161672803, 1085456384, 510515467, -939935104, -2002747375, -1969225728, -553132641, -2050592384, 1977946405, -1510719488, 346575763, -777579392, 109504089, 0, 928005735, 1540496256, 1556566829, 1935130624, 751106459, 1960001152, -1603783903, 2019557376, 1150900399, -684132992, -1742403147, -1866907648, 2008270627, -1118046080, -1746722199, 268435456, 231041143, 1706344320, -435375939, 1683275776, -886687701, 674431616, -1165299663, 18874368, -913692225, 1057700224, -103594939, 243679232, 503531699, 1701715072, -830777223, 0, 1858394247, 1855857536, 1137197133, 881442816, -1692699461, -136903040, 61642561, -1025507328, -1743900465, 1467694464, 1521066197, -1808056320, -1541621693, -335839104, -1543018359, -268435456, -191992169, -320059520, 1087889885, -1697202176, -20541621, -524465536, 1010370641, -1415577600, -2146349601, -645463680, -1085669531, 951599104, 1717433811, -1688066944, 2001154713, 0, -1134949721, -826463360, 272725357, 740016128, -1151244325, 1629736576, -421256351, 1499463680, 632774895, 921470336, 331235317, -52609024, 192733539, 1346373760, -226322775, 1342177280, 483888311, -2081501312, 1202903805, -482820096, -1413620117, -225930624, 657049713, -98566144, 2145143295, 1412024704, -1107803515, -745914368, -1626907917, 1131621504, 571045049, 0, 749655239, -1474350208, 1241641613, -384974848, -2100964613, 1672058496, 1338890113, -1411383296, -1500255985, 1652346240, 542238485, 1772044288, 1004749443, 874090624, -1162629943, 805306368, 419414743, 1286363008, 564960285, -1669677056, -1644485237, 310696576, 559689873, 1553989632, -240509409, -639397504, 202182053, -1375977472, 1187936275, -242142080, -1872683303, 0, 1273116391, -491504768, -883378259, -631259136, -403196389, 106454656, -1196903519, 710934528, 1730332975, -1826876032, 601069109, 427900928, 954129315, 1165498496, 1014606569, -1879048192, 1659244791, -988487808, -262920899, -2053324800, -890411861, -375250304, 760168625, 1126170624, 2042219071, 27548032, 775381189, -1223802880, -100512461, 1034697856, -194170631, },
-        { 0, 7, 896, 15309, 114688, 546875, 1959552, 5764801, 14680064, 33480783, 70000000, 136410197, 250822656, 439239619, 737894528, 1196015625, 1879048192, -1422596585, -9427072, 1962134877, 370065408, -277282101, 280636032, -1936025647, 2040528896, -225063585, 388096384, 208028389, -38780928, 490049875, -1528822656, -685229543, 0, 1976357415, -1703736448, -596487955, -1206665216, -1196790949, 2045161088, -1455627551, 123731968, 1775284335, -1132370560, 59765621, 1561673728, 51088611, 1296820352, -1281143255, -805306368, 1622647863, 1256632192, -1662409091, -1863270400, -1884392981, 857830016, 1232779249, -668991488, 516647295, -1698125440, 173041157, 1879195648, 377362035, -1810035584, -825566151, 0, -1193460665, -429321344, -705712627, 965066752, 749663867, 958953088, 1540880129, 165675008, 903469199, 1429581184, 1707178645, -212385792, 498273795, -1636732800, -818494391, -1342177280, -308446633, -396871808, -1161672803, 1085456384, 510515467, -939935104, -2002747375, -1969225728, -553132641, -2050592384, 1977946405, -1510719488, 346575763, -777579392, 109504089, 0, 928005735, 1540496256, 1556566829, 1935130624, 751106459, 1960001152, -1603783903, 2019557376, 1150900399, -684132992, -1742403147, -1866907648, 2008270627, -1118046080, -1746722199, 268435456, 231041143, 1706344320, -435375939, 1683275776, -886687701, 674431616, -1165299663, 18874368, -913692225, 1057700224, -103594939, 243679232, 503531699, 1701715072, -830777223, 0, 1858394247, 1855857536, 1137197133, 881442816, -1692699461, -136903040, 61642561, -1025507328, -1743900465, 1467694464, 1521066197, -1808056320, -1541621693, -335839104, -1543018359, -268435456, -191992169, -320059520, 1087889885, -1697202176, -20541621, -524465536, 1010370641, -1415577600, -2146349601, -645463680, -1085669531, 951599104, 1717433811, -1688066944, 2001154713, 0, -1134949721, -826463360, 272725357, 740016128, -1151244325, 1629736576, -421256351, 1499463680, 632774895, 921470336, 331235317, -52609024, 192733539, 1346373760, -226322775, 1342177280, 483888311, -2081501312, 1202903805, -482820096, -1413620117, -225930624, 657049713, -98566144, 2145143295, 1412024704, -1107803515, -745914368, -1626907917, 1131621504, 571045049, 0, 749655239, -1474350208, 1241641613, -384974848, -2100964613, 1672058496, 1338890113, -1411383296, -1500255985, 1652346240, 542238485, 1772044288, 1004749443, 874090624, -1162629943, 805306368, 419414743, 1286363008, 564960285, -1669677056, -1644485237, 310696576, 559689873, 1553989632, -240509409, -639397504, 202182053, -1375977472, 1187936275, -242142080, -1872683303, 0, 1273116391, -491504768, -883378259, -631259136, -403196389, 106454656, -1196903519, 710934528, 1730332975, -1826876032, 601069109, 427900928, 954129315, 1165498496, 1014606569, -1879048192, 1659244791, -988487808, -262920899, -2053324800, -890411861, -375250304, 760168625, 1126170624, 2042219071, 27548032, 775381189, -1223802880, -100512461, 1034697856, -194170631, },
-        { 0, 9, 1152, 19683, 147456, 703125, 2519424, 7411887, 18874368, 43046721, 90000000, 175384539, 322486272, 564736653, 948721536, 1537734375, -1879048192, -601919239, 1215012992, -545088941, -1364901888, -970072315, 974384512, 578657951, -1671430144, -902934223, -728152448, -346101685, 1177272320, 630064125, -738495616, -1494576169, 0, 1313897449, 263748736, -766913085, 902840320, -311597707, -1051907712, -1871521137, 1386217472, 441808161, 384795264, -1763858757, 167165952, 65685357, 1053773696, -1647184185, 805306368, 859128025, 388536448, -2137383117, 1285767168, -1809224219, -1351342720, 971435135, 367001600, 1891394321, -956170624, -391085269, -38158336, -1969087267, 1967778688, 165691319, 0, 2146951113, 675148928, 319788707, -599900160, -1490413483, 619372928, -1700268945, -400556032, -1906230527, -1229800832, 967810459, -1500200960, 1254204493, 963463040, 1401917095, 1342177280, -1010140999, 716869760, -266445805, 2009153536, 656377029, 1859345792, -734260641, -77594624, -1324737295, -182208896, 88806923, 1739046912, -167969347, -386178176, -472775785, 0, -647550039, -1700762496, 160599939, -1806942208, 1579275061, 1292867968, 392259151, 1369440256, 2093295841, 347533952, -1626665861, -1173176320, 741361965, -210354304, 1435614855, -268435456, -930080615, 1580304512, -1173335821, -2130755584, 87106469, 1480693120, 1569591359, -589299712, -1788313903, 1359900288, -133193493, -1527398400, -1193302371, -266347648, 1999691639, 0, -678469751, -68164480, 848543843, 519716864, 1505072661, -2016718464, 1919954991, 522190848, -401457471, -1794364800, 1955656539, 1970323456, 1085748749, 1408907136, 470386279, 268435456, -860413831, 815628416, 2012282323, 1499283456, 587156101, -674312832, 1299047967, 1247805440, -1532458831, 1624385152, -782294069, -1230782464, 1594562429, -943238272, -1108487337, 0, 1608612713, -449028992, -262919869, 1565016064, -1480171275, 254675328, -1155182065, -526385152, -413565791, -1883086208, 425873979, 1773060096, 861367021, 503918464, -290986425, -1342177280, -604991399, -2062649216, -2134809933, -1847902208, -1817511579, -1517615744, 1458344959, -740294656, 303774353, -25239936, -1424318805, 2108801024, 1589661789, -385758336, -1720066249, 0, -263291063, -1282026368, 982829603, 1345732608, -860539947, -918044288, -732836881, 639631360, -701767039, 283744896, 1310730523, -2016624640, 1905387469, -1330436224, 345890343, -805306368, -1301452743, 1653895296, -1727889517, 1534672896, 953495621, -2054800000, -1734665761, 157286400, -309226383, 405051008, 1487081867, -1155547136, -926920387, -924892288, 46531351, 0, -817403095, 1208765568, 1318494979, 415514624, 1935871669, 136870272, -1538875953, 2141192192, -2070253471, -1735273856, -454330373, 550158336, -613962579, -955768960, 77360647, 1879048192, -320952295, -1270912896, -1565174669, -2026422272, 1923018533, 131102080, -863340609, 2061500416, 1398576721, 1876119168, 383351915, 267239424, -129230307, -1737507968, 977485559, },
-        { 0, 2, 256, 4374, 32768, 156250, 559872, 1647086, 4194304, 9565938, 20000000, 38974342, 71663616, 125497034, 210827008, 341718750, 536870912, 820677346, 1224440064, 1787743478, -1734967296, -692790214, 693748480, -1780283698, 583008256, -677870638, -1116248832, -554130074, 1216053248, 140014250, 790327040, -809346626, 0, -662459966, 1967485184, -170425130, 2109505536, 885193242, 1197898496, -415893586, 1262485504, -1333476174, 1517165824, -1823624378, -1394507776, 14596746, -243046656, -366040930, 1610612736, -763519838, -868095744, -474974026, -1145929728, 75168762, 2085794560, -261344114, 1035993088, 1374747026, 741954816, -564126426, -1917353984, 1948517994, -517153024, 991257470, 0, -954555518, 1104470272, 1025501334, -1564966912, 2054889946, -339580160, 1053818222, -566231040, 1485267570, 1635585280, -739368186, -1287815168, 755930698, -1694771456, -2074555810, -1610612736, -701694366, 1113741568, 895226998, 923697152, 145861562, -1495686400, 1268486734, 1891631104, -771604654, 1868383488, -1889139482, -1045200896, -514545110, 391401216, -582279874, 0, -1575555774, 1053708544, -1395966890, 552894464, 828168602, -667133184, 1996043054, -650117120, 942395442, 1031666944, 115737286, 693731328, -1266908662, 907691776, -1112630242, -536870912, -1161121758, -126039808, -737959882, 480935936, 973794170, 806261504, -1560076274, -608174080, -874621678, 302200064, -29598554, -1771077632, -1696834070, -1968062720, -1464498434, 0, 1758103298, -1924022016, -288653290, -361725952, -1097195174, -1879815424, 1858312430, 1547698176, 1342442994, 1032908032, 434590342, -516587520, -1667596854, 1744746240, 2013404638, 536870912, -668421662, 1135687936, 924392438, -1098481664, 607697722, -149847296, 288677326, -1631584256, 613890770, -2025118464, 303375462, 2112585728, -122871382, 744828672, 1185325246, 0, -1551404862, 377434368, -535645226, 824999936, -328926950, -1375061248, -733925714, -2025848832, -1046340686, 1490410752, 94638662, 1825669120, 668633482, -842455296, -64663650, 1610612736, -1088879710, 18852096, 957253558, -1365082112, -403891462, -1291685120, 801295246, -641728512, -1841368942, -1437264640, -316515290, -1440251904, -1078397590, -1517379840, 2003855998, 0, -1012946302, 192323840, -258812010, 1730707456, 1240424666, 1704864512, -2071726994, 2051014656, 798488946, -1368601344, 768492038, 506298368, 900638026, 2090440448, 1508520286, -1610612736, -1720867486, 367532288, 2002117494, -1090617344, -1696986438, 1929470720, 2000611662, -1396703232, -68716974, 1044448512, 1284899814, 220430336, -2114856662, -682750208, 1919214654, 0, -2090519486, 1700270336, -2093094058, 1046773760, -1955899238, 30415616, -341972434, 1430257664, 494380850, 91602176, -1055399482, 122257408, -1568091894, -2121267456, -937245922, -536870912, -1980197086, -282425088, -1302253770, 26902528, -1481536902, 506352384, -1623509234, 935329792, -643642350, 1848571136, -392029274, 1491042304, -28717846, 1522761472, 1171656190, },
-        { 0, 1, 128, 2187, 16384, 78125, 279936, 823543, 2097152, 4782969, 10000000, 19487171, 35831808, 62748517, 105413504, 170859375, 268435456, 410338673, 612220032, 893871739, 1280000000, 1801088541, -1800609408, -890141849, 291504128, 1808548329, -558124416, 1870418611, 608026624, 70007125, 395163520, 1742810335, 0, -331229983, 983742592, -85212565, 1054752768, 442596621, -1548534400, -207946793, 631242752, 1480745561, -1388900736, 1235671459, 1450229760, 7298373, 2025960320, -183020465, -1342177280, -381759919, -434047872, -237487013, 1574518784, -2109899267, -1104586368, 2016811591, 517996544, 687373513, 370977408, 1865420435, -958676992, -1173224651, -258576512, 495628735, 0, 1670205889, 552235136, 512750667, 1365000192, -1120038675, 1977693568, -1620574537, 1864368128, 742633785, 817792640, -369684093, -643907584, -1769518299, -847385728, 1110205743, -805306368, 1796636465, 556870784, 447613499, -1685635072, 72930781, -747843200, -1513240281, 945815552, 1761681321, 934191744, -944569741, 1624883200, 1890211093, -1951783040, 1856343711, 0, 1359705761, -1620629376, 1449500203, 276447232, -1733399347, -333566592, 998021527, -325058560, -1676285927, 515833472, -2089615005, 346865664, 1514029317, 453845888, 1591168527, 1879048192, -580560879, 2084463744, 1778503707, 240467968, 486897085, -1744352896, -780038137, 1843396608, 1710172809, 151100032, -14799277, 1261944832, 1299066613, -984031360, -732249217, 0, 879051649, -962011008, 2003157003, 1966620672, 1598886061, 1207575936, -1218327433, -1373634560, -1476262151, -1631029632, 217295171, -258293760, -833798427, -1275110528, 1006702319, -1879048192, 1813272817, 567843968, -1685287429, 1598242816, -1843634787, -74923648, 144338663, -815792128, 306945385, 1134924416, -1995795917, -1091190784, 2086047957, 372414336, -1554821025, 0, -775702431, -1958766464, 1879661035, -1734983680, -164463475, 1459953024, 1780520791, -1012924416, -523170343, 745205376, 47319331, -1234649088, -1813166907, -421227648, -32331825, 805306368, -544439855, -2138057600, -1668856869, -682541056, -201945731, -645842560, -1746836025, 1826619392, -920684471, 1428851328, -158257645, -720125952, 1608284853, 1388793728, -1145555649, 0, -506473151, -2051321728, 2018077643, -1282129920, -1527271315, 852432256, -1035863497, 1025507328, 399244473, 1463182976, -1763237629, 253149184, -1697164635, -1102263424, -1393223505, 1342177280, 1287049905, 183766144, -1146424901, 1602174976, -848493219, -1182748288, -1147177817, 1449132032, -34358487, 522224256, 642449907, -2037268480, -1057428331, 1806108544, 959607327, 0, -1045259743, -1297348480, 1100936619, 523386880, 1169534029, 15207808, -170986217, 715128832, 247190425, -2101682560, -527699741, 61128704, 1363437701, -1060633728, -468622961, -268435456, -990098543, -141212544, -651126885, -2134032384, -740768451, -1894307456, 1335729031, -1679818752, -321821175, -1223198080, 1951469011, -1401962496, -14358923, 761380736, 585828095, }
-    }
-};
+/*
+ * c[row][degree] * m^(degree+1) mod 256 for every byte value, generated at compile time as bytes. mix_columns() below
+ * evaluates degrees 0-2 directly and looks up degrees 3-6.
+ */
+alignas(64) constexpr MixTerms<BLOCK_SIZE> mixTerms = make_mix_terms(polynomialCoefficients);
 
 void mix_columns() {
 #pragma GCC unroll 7
@@ -211,66 +186,66 @@ void mix_columns() {
         res += pc[0][0] * message[0][column];
         res += pc[0][1] * sq;
         res += pc[0][2] * trip;
-        res += full_retard[0][0][message[3][column]];
-        res += full_retard[1][0][message[4][column]];
-        res += full_retard[2][0][message[5][column]];
-        res += full_retard[3][0][message[6][column]];
+        res += mixTerms.term[0][3][message[3][column]];
+        res += mixTerms.term[0][4][message[4][column]];
+        res += mixTerms.term[0][5][message[5][column]];
+        res += mixTerms.term[0][6][message[6][column]];
         message[0][column] = res;
         res = 0;
         res += pc[1][0] * message[0][column];
         res += pc[1][1] * sq;
         res += pc[1][2] * trip;
-        res += full_retard[0][1][message[3][column]];
-        res += full_retard[1][1][message[4][column]];
-        res += full_retard[2][1][message[5][column]];
-        res += full_retard[3][1][message[6][column]];
+        res += mixTerms.term[1][3][message[3][column]];
+        res += mixTerms.term[1][4][message[4][column]];
+        res += mixTerms.term[1][5][message[5][column]];
+        res += mixTerms.term[1][6][message[6][column]];
         message[1][column] = res;
         sq = res * res;
         res = 0;
         res += pc[2][0] * message[0][column];
         res += pc[2][1] * sq;
         res += pc[2][2] * trip;
-        res += full_retard[0][2][message[3][column]];
-        res += full_retard[1][2][message[4][column]];
-        res += full_retard[2][2][message[5][column]];
-        res += full_retard[3][2][message[6][column]];
+        res += mixTerms.term[2][3][message[3][column]];
+        res += mixTerms.term[2][4][message[4][column]];
+        res += mixTerms.term[2][5][message[5][column]];
+        res += mixTerms.term[2][6][message[6][column]];
         message[2][column] = res;
         trip = res * res * res;
         res = 0;
         res += pc[3][0] * message[0][column];
         res += pc[3][1] * sq;
         res += pc[3][2] * trip;
-        res += full_retard[0][3][message[3][column]];
-        res += full_retard[1][3][message[4][column]];
-        res += full_retard[2][3][message[5][column]];
-        res += full_retard[3][3][message[6][column]];
+        res += mixTerms.term[3][3][message[3][column]];
+        res += mixTerms.term[3][4][message[4][column]];
+        res += mixTerms.term[3][5][message[5][column]];
+        res += mixTerms.term[3][6][message[6][column]];
         message[3][column] = res;
         res = 0;
         res += pc[4][0] * message[0][column];
         res += pc[4][1] * sq;
         res += pc[4][2] * trip;
-        res += full_retard[0][4][message[3][column]];
-        res += full_retard[1][4][message[4][column]];
-        res += full_retard[2][4][message[5][column]];
-        res += full_retard[3][4][message[6][column]];
+        res += mixTerms.term[4][3][message[3][column]];
+        res += mixTerms.term[4][4][message[4][column]];
+        res += mixTerms.term[4][5][message[5][column]];
+        res += mixTerms.term[4][6][message[6][column]];
         message[4][column] = res;
         res = 0;
         res += pc[5][0] * message[0][column];
         res += pc[5][1] * sq;
         res += pc[5][2] * trip;
-        res += full_retard[0][5][message[3][column]];
-        res += full_retard[1][5][message[4][column]];
-        res += full_retard[2][5][message[5][column]];
-        res += full_retard[3][5][message[6][column]];
+        res += mixTerms.term[5][3][message[3][column]];
+        res += mixTerms.term[5][4][message[4][column]];
+        res += mixTerms.term[5][5][message[5][column]];
+        res += mixTerms.term[5][6][message[6][column]];
         message[5][column] = res;
         res = 0;
         res += pc[6][0] * message[0][column];
         res += pc[6][1] * sq;
         res += pc[6][2] * trip;
-        res += full_retard[0][6][message[3][column]];
-        res += full_retard[1][6][message[4][column]];
-        res += full_retard[2][6][message[5][column]];
-        res += full_retard[3][6][message[6][column]];
+        res += mixTerms.term[6][3][message[3][column]];
+        res += mixTerms.term[6][4][message[4][column]];
+        res += mixTerms.term[6][5][message[5][column]];
+        res += mixTerms.term[6][6][message[6][column]];
         message[6][column] = res;
     }
 }
@@ -278,24 +253,24 @@ void mix_columns() {
 inline void add_key() {
     uint8_t *p = &(message[0][0]);
     uint8_t *k = &(key[0][0]);
-    __m128i x = _mm_load_si128(reinterpret_cast<__m128i*>(p));
-    __m128i x1 = _mm_load_si128(reinterpret_cast<__m128i*>(k));
+    __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i*>(p));
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(k));
     __m128i x2 = _mm_xor_si128(x, x1);
-    _mm_store_si128((__m128i *)p, x2);
+    _mm_storeu_si128((__m128i *)p, x2);
 
     p = &(message[2][2]);
     k = &(key[2][2]);
-    x = _mm_load_si128(reinterpret_cast<__m128i*>(p));
-    x1 = _mm_load_si128(reinterpret_cast<__m128i*>(k));
+    x = _mm_loadu_si128(reinterpret_cast<__m128i*>(p));
+    x1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(k));
     x2 = _mm_xor_si128(x, x1);
-    _mm_store_si128((__m128i *)p, x2);
+    _mm_storeu_si128((__m128i *)p, x2);
 
     p = &(message[4][4]);
     k = &(key[4][4]);
-    x = _mm_load_si128(reinterpret_cast<__m128i*>(p));
-    x1 = _mm_load_si128(reinterpret_cast<__m128i*>(k));
+    x = _mm_loadu_si128(reinterpret_cast<__m128i*>(p));
+    x1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(k));
     x2 = _mm_xor_si128(x, x1);
-    _mm_store_si128((__m128i *)p, x2);
+    _mm_storeu_si128((__m128i *)p, x2);
 
     message[6][6] ^= key[6][6];
 }
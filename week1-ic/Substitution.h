@@ -0,0 +1,174 @@
+#ifndef SUBSTITUTION_H
+#define SUBSTITUTION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <immintrin.h>
+
+#include "Utility.h"
+
+/*
+ * The substitution as a direct lookup table: map[keys[i]] = values[i]. Applying it to a byte is one load instead of a
+ * search through keys.
+ */
+struct SubstitutionTable
+{
+    alignas(64) uint8_t map[UNIQUE_CHARACTERS];
+};
+
+inline void build_substitution(SubstitutionTable &table, const uint8_t *keys, const uint8_t *values)
+{
+    for (int i = 0; i < UNIQUE_CHARACTERS; ++i)
+    {
+        table.map[keys[i]] = values[i];
+    }
+}
+
+/*
+ * Writes the table entry of every byte of input to output (which may be the same buffer). The table does not fit into
+ * a single shuffle, so it is split: with VBMI two 128-entry vpermi2b lookups are blended on the top bit of each byte,
+ * otherwise sixteen 16-entry pshufb lookups are blended on the high nibble. A partial vector at the end goes through a
+ * zero-padded buffer.
+ */
+inline void apply_substitution(const uint8_t *input, uint8_t *output, size_t length, const SubstitutionTable &table)
+{
+#if defined(__AVX512VBMI__)
+    const __m512i t0 = _mm512_load_si512(table.map);
+    const __m512i t1 = _mm512_load_si512(table.map + 64);
+    const __m512i t2 = _mm512_load_si512(table.map + 128);
+    const __m512i t3 = _mm512_load_si512(table.map + 192);
+    for (size_t i = 0; i < length; i += 64)
+    {
+        // A masked load and store handle the tail without touching memory past the end.
+        const __mmask64 mask = length - i >= 64 ? ~0ull : (1ull << (length - i)) - 1;
+        const __m512i x = _mm512_maskz_loadu_epi8(mask, input + i);
+        const __m512i low = _mm512_permutex2var_epi8(t0, x, t1);
+        const __m512i high = _mm512_permutex2var_epi8(t2, x, t3);
+        _mm512_mask_storeu_epi8(output + i, mask, _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), low, high));
+    }
+#elif defined(__AVX2__)
+    __m256i tables[UNIQUE_CHARACTERS / 16];
+    for (int k = 0; k < UNIQUE_CHARACTERS / 16; ++k)
+    {
+        tables[k] = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)(table.map + 16 * k)));
+    }
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    for (size_t i = 0; i < length; i += 32)
+    {
+        alignas(32) uint8_t tail[32] = {};
+        const bool partial = length - i < 32;
+        if (partial)
+        {
+            memcpy(tail, input + i, length - i);
+        }
+
+        const __m256i x = _mm256_loadu_si256((const __m256i *)(partial ? tail : input + i));
+        const __m256i low = _mm256_and_si256(x, nibble);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+        __m256i result = _mm256_setzero_si256();
+        for (int k = 0; k < UNIQUE_CHARACTERS / 16; ++k)
+        {
+            const __m256i hit = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(k));
+            result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(tables[k], low), hit);
+        }
+        if (partial)
+        {
+            _mm256_store_si256((__m256i *)tail, result);
+            memcpy(output + i, tail, length - i);
+        }
+        else
+        {
+            _mm256_storeu_si256((__m256i *)(output + i), result);
+        }
+    }
+#else
+    for (size_t i = 0; i < length; ++i)
+    {
+        output[i] = table.map[input[i]];
+    }
+#endif
+}
+
+inline void apply_substitution(uint8_t *data, size_t length, const SubstitutionTable &table)
+{
+    apply_substitution(data, data, length, table);
+}
+
+/*
+ * The substitution split into its disjoint cycles. elements holds all cycles one after another, each in the order
+ * the substitution walks it. For every byte value x, start[x] and length[x] describe the cycle containing x and
+ * offset[x] is the position of x within it.
+ */
+struct SubstitutionCycles
+{
+    uint8_t elements[UNIQUE_CHARACTERS];
+    uint8_t start[UNIQUE_CHARACTERS];
+    uint8_t offset[UNIQUE_CHARACTERS];
+    uint16_t length[UNIQUE_CHARACTERS];
+    int count;
+};
+
+inline void decompose_substitution(SubstitutionCycles &cycles, const SubstitutionTable &table)
+{
+    bool visited[UNIQUE_CHARACTERS] = {};
+    int next = 0;
+    cycles.count = 0;
+    for (int first = 0; first < UNIQUE_CHARACTERS; ++first)
+    {
+        if (visited[first])
+        {
+            continue;
+        }
+
+        const int start = next;
+        for (int x = first; !visited[x]; x = table.map[x])
+        {
+            visited[x] = true;
+            cycles.elements[next] = x;
+            cycles.start[x] = start;
+            cycles.offset[x] = next - start;
+            ++next;
+        }
+        for (int i = start; i < next; ++i)
+        {
+            cycles.length[cycles.elements[i]] = next - start;
+        }
+        ++cycles.count;
+    }
+}
+
+/*
+ * The substitution applied exponent times, as a single table. Applying it exponent times moves every byte exponent
+ * places along its cycle, so each entry is one lookup at offset (offset + exponent) mod length: O(256) for any
+ * exponent.
+ */
+inline void cycle_power_substitution(SubstitutionTable &result, const SubstitutionCycles &cycles,
+                                     unsigned long long exponent)
+{
+    // Cycles have at most 256 elements, so exponent mod length only needs to be computed once per length.
+    uint16_t shift[UNIQUE_CHARACTERS + 1];
+    for (int length = 1; length <= UNIQUE_CHARACTERS; ++length)
+    {
+        shift[length] = exponent % length;
+    }
+    for (int x = 0; x < UNIQUE_CHARACTERS; ++x)
+    {
+        const int length = cycles.length[x];
+        const int offset = (cycles.offset[x] + shift[length]) % length;
+        result.map[x] = cycles.elements[cycles.start[x] + offset];
+    }
+}
+
+/*
+ * Applies the substitution exponent times to every byte of data in O(length), independent of the exponent.
+ */
+inline void apply_substitution_power(uint8_t *data, size_t length, const SubstitutionCycles &cycles,
+                                     unsigned long long exponent)
+{
+    SubstitutionTable power;
+    cycle_power_substitution(power, cycles, exponent);
+    apply_substitution(data, length, power);
+}
+
+#endif // SUBSTITUTION_H
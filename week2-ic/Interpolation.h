@@ -0,0 +1,164 @@
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+
+#include <cstring>
+#include <vector>
+
+#include "Utility.h"
+
+/*
+ * Everything about the datapoints that compute_vel() needs, prepared once after generate_test() instead of on every
+ * call. The number of datapoints is chosen at run time; count is NUM_DATAPOINTS for the original problem.
+ *
+ * The interpolating polynomial has degree count - 1 over randomly placed nodes, so it is extremely
+ * ill-conditioned: for most velocities the value is far beyond 1e15, where the fmod() in compute_vel() only sees
+ * rounding noise. Any other way of evaluating the polynomial (Newton, barycentric, ...) therefore yields different
+ * velocities and a different crashed count. interpolate() keeps Neville's exact sequence of floating point operations
+ * and only removes the redundant work, so its results are bit-identical to the original tableau.
+ * interpolate_newton() evaluates the same polynomial in O(count) without divisions, which is only
+ * interchangeable where the polynomial is well-conditioned.
+ */
+struct Interpolation
+{
+    int count = 0;
+    std::vector<double> x;
+    std::vector<double> y;
+    // span[k * count + i] = x[i + k] - x[i], the denominators of column k of the Neville tableau.
+    std::vector<double> span;
+    // Divided differences f[x0, ..., xi], the coefficients of the Newton form.
+    std::vector<double> newton;
+};
+
+inline Interpolation interpolation;
+
+inline void prepare_interpolation(const double (*datapoints)[2], int count)
+{
+    interpolation.count = count;
+    interpolation.x.resize(count);
+    interpolation.y.resize(count);
+    interpolation.span.assign((size_t)count * count, 0.0);
+    interpolation.newton.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        interpolation.x[i] = datapoints[i][0];
+        interpolation.y[i] = datapoints[i][1];
+        interpolation.newton[i] = datapoints[i][1];
+    }
+
+    for (int k = 1; k < count; k++)
+    {
+        for (int i = 0; i < count - k; i++)
+        {
+            interpolation.span[(size_t)k * count + i] = interpolation.x[i + k] - interpolation.x[i];
+        }
+        for (int i = count - 1; i >= k; i--)
+        {
+            interpolation.newton[i] = (interpolation.newton[i] - interpolation.newton[i - 1]) /
+                                      (interpolation.x[i] - interpolation.x[i - k]);
+        }
+    }
+}
+
+/*
+ * Number of independent evaluations interpolate_lanes() handles at once: one zmm, ymm or xmm register of doubles.
+ */
+#if defined(__AVX512F__)
+constexpr int INTERPOLATION_LANES = 8;
+#elif defined(__AVX__)
+constexpr int INTERPOLATION_LANES = 4;
+#else
+constexpr int INTERPOLATION_LANES = 2;
+#endif
+
+typedef double interpolation_vector __attribute__((vector_size(INTERPOLATION_LANES * sizeof(double))));
+
+/*
+ * The columns of the tableau that interpolate() and interpolate_lanes() update in place. Every thread that evaluates
+ * the polynomial owns one, sized once by prepare_scratch(), so the evaluations themselves do not allocate.
+ */
+struct InterpolationScratch
+{
+    std::vector<double> p, offset;
+    std::vector<interpolation_vector> lanes, lane_offsets;
+};
+
+inline void prepare_scratch(InterpolationScratch &scratch)
+{
+    scratch.p.resize(interpolation.count);
+    scratch.offset.resize(interpolation.count);
+    scratch.lanes.resize(interpolation.count);
+    scratch.lane_offsets.resize(interpolation.count);
+}
+
+/*
+ * Neville's algorithm with the same operations as the original tableau, bit for bit. Only column k - 1 is needed to
+ * compute column k, and p[i + 1] is read before it is overwritten, so one column is updated in place; x - x[i] and the
+ * denominators are computed once. The inner loop has no dependencies between iterations and vectorizes.
+ */
+inline double interpolate(double x, InterpolationScratch &scratch)
+{
+    const int count = interpolation.count;
+    double *p = scratch.p.data();
+    double *offset = scratch.offset.data();
+    for (int i = 0; i < count; i++)
+    {
+        p[i] = interpolation.y[i];
+        offset[i] = x - interpolation.x[i];
+    }
+
+    for (int k = 1; k < count; k++)
+    {
+        const double *span = &interpolation.span[(size_t)k * count];
+        for (int i = 0; i < count - k; i++)
+        {
+            p[i] = p[i] + (offset[i] / span[i]) * (p[i + 1] - p[i]);
+        }
+    }
+    return p[0];
+}
+
+/*
+ * interpolate() for INTERPOLATION_LANES values of x at once, one per vector lane. Every lane goes through exactly the
+ * same operations as interpolate(), so the results are bit-identical, and every column of the tableau is a full vector
+ * regardless of its length. The divisions dominate, so the gain over interpolate() is bounded by the divider
+ * throughput rather than the vector width.
+ */
+inline void interpolate_lanes(const double *x, double *result, InterpolationScratch &scratch)
+{
+    interpolation_vector values;
+    memcpy(&values, x, sizeof(values));
+
+    const int count = interpolation.count;
+    interpolation_vector *p = scratch.lanes.data();
+    interpolation_vector *offset = scratch.lane_offsets.data();
+    for (int i = 0; i < count; i++)
+    {
+        p[i] = interpolation_vector{} + interpolation.y[i];
+        offset[i] = values - interpolation.x[i];
+    }
+
+    for (int k = 1; k < count; k++)
+    {
+        const double *span = &interpolation.span[(size_t)k * count];
+        for (int i = 0; i < count - k; i++)
+        {
+            p[i] = p[i] + (offset[i] / span[i]) * (p[i + 1] - p[i]);
+        }
+    }
+    memcpy(result, &p[0], sizeof(p[0]));
+}
+
+/*
+ * The Newton form, evaluated with Horner's scheme: one multiplication and one addition per datapoint.
+ */
+inline double interpolate_newton(double x)
+{
+    double result = interpolation.newton[interpolation.count - 1];
+    for (int i = interpolation.count - 2; i >= 0; i--)
+    {
+        result = result * (x - interpolation.x[i]) + interpolation.newton[i];
+    }
+    return result;
+}
+
+#endif // INTERPOLATION_H
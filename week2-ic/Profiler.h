@@ -0,0 +1,214 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Scoped timers for the phases of a run, enabled by defining PROFILE_PHASES before this header is included:
+ *
+ *     {
+ *         ScopedPhase phase(PHASE_HIT_COUNTING);
+ *         ...
+ *     }
+ *
+ * Every thread claims its own slot on first use and accumulates count, total time and a log2 latency histogram per
+ * phase there with plain stores, so timing a scope is two timestamp reads and no shared writes. Timestamps are rdtsc
+ * where available (steady_clock otherwise), converted to nanoseconds against steady_clock over the whole run. At exit
+ * the slots are merged and written as JSON to the file named by $PROFILE_JSON, or to stderr.
+ *
+ * Phases nest: a phase that contains another includes its time. Without PROFILE_PHASES, ScopedPhase is empty.
+ */
+enum Phase
+{
+    PHASE_GENERATE_TEST,
+    PHASE_PREPARE,
+    PHASE_VELOCITY_UPDATE,
+    PHASE_HIT_COUNTING,
+    PHASE_FAST_FORWARD,
+    PHASE_THREAD_JOIN,
+    PHASE_COUNT
+};
+
+static const char *const phaseNames[PHASE_COUNT] = {"generate_test", "prepare", "velocity_update",
+                                                   "hit_counting",  "fast_forward", "thread_join"};
+
+#ifdef PROFILE_PHASES
+
+class Profiler
+{
+public:
+    static constexpr int MAX_THREADS = 256;
+    static constexpr int HISTOGRAM_BUCKETS = 48;
+
+    Profiler()
+    {
+        startTicks = ticks();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    ~Profiler()
+    {
+        report();
+    }
+
+    static uint64_t ticks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+    void record(Phase phase, uint64_t elapsed)
+    {
+        thread_local ThreadProfile *profile = claim();
+        if (profile == nullptr)
+        {
+            return;
+        }
+        int bucket = 0;
+        while (bucket < HISTOGRAM_BUCKETS - 1 && elapsed >> (bucket + 1) != 0)
+        {
+            bucket++;
+        }
+        profile->count[phase]++;
+        profile->total[phase] += elapsed;
+        profile->histogram[phase][bucket]++;
+    }
+
+private:
+    // One per thread, on its own cache lines; histogram[phase][b] counts scopes of [2^b, 2^(b + 1)) ticks.
+    struct alignas(64) ThreadProfile
+    {
+        uint64_t count[PHASE_COUNT];
+        uint64_t total[PHASE_COUNT];
+        uint64_t histogram[PHASE_COUNT][HISTOGRAM_BUCKETS];
+    };
+
+    ThreadProfile *claim()
+    {
+        const int slot = numThreads.fetch_add(1, std::memory_order_relaxed);
+        return slot < MAX_THREADS ? &profiles[slot] : nullptr;
+    }
+
+    // Runs after main() returned, so every thread that recorded anything has been joined.
+    void report()
+    {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        const double ticksPerNs = seconds > 0 ? (ticks() - startTicks) / (seconds * 1e9) : 1.0;
+        const int threads = std::min<int>(numThreads.load(), MAX_THREADS);
+
+        const char *path = getenv("PROFILE_JSON");
+        FILE *out = path ? fopen(path, "w") : stderr;
+        if (out == nullptr)
+        {
+            perror(path);
+            return;
+        }
+
+        fprintf(out, "{\n  \"clock\": \"%s\",\n  \"ticks_per_ns\": %.6f,\n  \"threads\": %d,\n  \"phases\": {",
+#if defined(__x86_64__) || defined(__i386__)
+                "rdtsc",
+#else
+                "steady_clock",
+#endif
+                ticksPerNs, threads);
+        const char *separator = "";
+        for (int phase = 0; phase < PHASE_COUNT; phase++)
+        {
+            uint64_t count = 0, total = 0, histogram[HISTOGRAM_BUCKETS] = {};
+            for (int t = 0; t < threads; t++)
+            {
+                count += profiles[t].count[phase];
+                total += profiles[t].total[phase];
+                for (int b = 0; b < HISTOGRAM_BUCKETS; b++)
+                {
+                    histogram[b] += profiles[t].histogram[phase][b];
+                }
+            }
+            if (count == 0)
+            {
+                continue;
+            }
+
+            fprintf(out,
+                    "%s\n    \"%s\": {\n      \"count\": %llu,\n      \"total_ns\": %.0f,\n      \"mean_ns\": %.1f,",
+                    separator, phaseNames[phase], (unsigned long long)count, total / ticksPerNs,
+                    total / ticksPerNs / count);
+            fprintf(out, "\n      \"per_thread_total_ns\": [");
+            for (int t = 0; t < threads; t++)
+            {
+                fprintf(out, "%s%.0f", t ? ", " : "", profiles[t].total[phase] / ticksPerNs);
+            }
+            // Only the occupied buckets, each with its upper bound.
+            fprintf(out, "],\n      \"histogram\": [");
+            const char *bucketSeparator = "";
+            for (int b = 0; b < HISTOGRAM_BUCKETS; b++)
+            {
+                if (histogram[b] != 0)
+                {
+                    fprintf(out, "%s{\"lt_ns\": %.0f, \"count\": %llu}", bucketSeparator,
+                            (double)(2ull << b) / ticksPerNs, (unsigned long long)histogram[b]);
+                    bucketSeparator = ", ";
+                }
+            }
+            fprintf(out, "]\n    }");
+            separator = ",";
+        }
+        fprintf(out, "\n  }\n}\n");
+        if (out != stderr)
+        {
+            fclose(out);
+        }
+    }
+
+    ThreadProfile profiles[MAX_THREADS] = {};
+    std::atomic<int> numThreads{0};
+    uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+inline Profiler profiler;
+
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(Phase phase) : phase(phase), start(Profiler::ticks())
+    {
+    }
+
+    ~ScopedPhase()
+    {
+        profiler.record(phase, Profiler::ticks() - start);
+    }
+
+private:
+    Phase phase;
+    uint64_t start;
+};
+
+#else
+
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(Phase)
+    {
+    }
+};
+
+#endif // PROFILE_PHASES
+
+#endif // PROFILER_H
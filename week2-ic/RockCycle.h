@@ -0,0 +1,135 @@
+#ifndef ROCK_CYCLE_H
+#define ROCK_CYCLE_H
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * One rock, laid out as update_rocks() expects a batch of two entries: row, then column.
+ */
+struct RockState
+{
+    unsigned int pos[2];
+    double vel[2];
+
+    bool operator==(const RockState &other) const
+    {
+        // Bit patterns: the next step depends on the exact velocity, not on a value that compares equal.
+        return memcmp(pos, other.pos, sizeof(pos)) == 0 && memcmp(vel, other.vel, sizeof(vel)) == 0;
+    }
+
+    bool operator!=(const RockState &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/*
+ * Number of m in (low, high] with m = a (mod p) and m = b (mod q), where a < p and b < q. By the Chinese remainder
+ * theorem these m form one residue class modulo lcm(p, q), or none if a and b differ modulo gcd(p, q).
+ */
+inline uint64_t count_congruent(uint64_t low, uint64_t high, uint64_t a, uint64_t p, uint64_t b, uint64_t q)
+{
+    uint64_t g = p, r = q;
+    while (r != 0)
+    {
+        const uint64_t t = g % r;
+        g = r;
+        r = t;
+    }
+    if (a % g != b % g)
+    {
+        return 0;
+    }
+
+    // m = a + p k with (p / g) k = (b - a) / g (mod q / g); solve for k with the inverse of p / g.
+    const uint64_t modulus = q / g;
+    int64_t inverse = 0;
+    if (modulus > 1)
+    {
+        int64_t r0 = (p / g) % modulus, r1 = modulus, s0 = 1, s1 = 0;
+        while (r1 != 0)
+        {
+            const int64_t quotient = r0 / r1;
+            int64_t t = r0 - quotient * r1;
+            r0 = r1;
+            r1 = t;
+            t = s0 - quotient * s1;
+            s0 = s1;
+            s1 = t;
+        }
+        inverse = (s0 % (int64_t)modulus + modulus) % modulus;
+    }
+    const uint64_t difference = (b + q - a % q) % q / g;
+    const uint64_t k = modulus > 1 ? (unsigned __int128)difference * inverse % modulus : 0;
+
+    const unsigned __int128 period = (unsigned __int128)p * modulus;
+    const unsigned __int128 first = a + (unsigned __int128)p * k;
+    auto up_to = [period, first](uint64_t x) -> uint64_t
+    {
+        return x < first ? 0 : (uint64_t)((x - first) / period + 1);
+    };
+    return up_to(high) - up_to(low);
+}
+
+/*
+ * How often the rock is on the ship's cell over steps steps, where the ship is at (i mod mapSize, i mod mapSize)
+ * during step i. step(state) advances a rock by one step.
+ *
+ * A rock evolves independently of everything else, and its trajectory ends up in a cycle. Brent's algorithm finds it
+ * while the rock is simulated: the hare is the simulation itself, hits are counted as it goes, and the tortoise waits
+ * at powers of two. Once the hare meets the tortoise, the states from the tortoise on repeat with period lambda, so
+ * for every state of the cycle that lies on the diagonal, the remaining hits are the steps that agree both with its
+ * place in the cycle (mod lambda) and with the ship being on its cell (mod mapSize). The cost is O(tail + cycle)
+ * steps, independent of steps.
+ */
+template <typename Step>
+uint64_t count_rock_hits(RockState rock, uint64_t steps, uint32_t mapSize, Step step)
+{
+    // The state after n updates is compared with the ship during step n - 1.
+    auto hit = [mapSize](const RockState &state, uint64_t n)
+    {
+        return state.pos[0] == state.pos[1] && state.pos[0] == (n - 1) % mapSize;
+    };
+
+    uint64_t hits = 0;
+    RockState tortoise = rock;
+    uint64_t tortoiseIndex = 0, power = 1, lambda = 0, n = 0;
+    while (n < steps)
+    {
+        step(rock);
+        n++;
+        lambda++;
+        hits += hit(rock, n);
+        if (rock == tortoise)
+        {
+            break;
+        }
+        if (lambda == power)
+        {
+            tortoise = rock;
+            tortoiseIndex = n;
+            power *= 2;
+            lambda = 0;
+        }
+    }
+    if (n == steps)
+    {
+        return hits;
+    }
+
+    // The cycle is the states tortoiseIndex + j for j < lambda; count the hits after step n on each of them.
+    RockState state = tortoise;
+    for (uint64_t j = 0; j < lambda; j++)
+    {
+        if (state.pos[0] == state.pos[1] && state.pos[0] < mapSize)
+        {
+            hits += count_congruent(n, steps, (tortoiseIndex + j) % lambda, lambda, (state.pos[0] + 1) % mapSize,
+                                    mapSize);
+        }
+        step(state);
+    }
+    return hits;
+}
+
+#endif // ROCK_CYCLE_H
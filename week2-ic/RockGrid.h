@@ -0,0 +1,153 @@
+#ifndef ROCK_GRID_H
+#define ROCK_GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Spatial index over the cells of a mapSize x mapSize map: for every bucket of cells a linked list of the rocks in it.
+ * Moving a rock unlinks it from one list and links it into another, so keeping the index up to date costs O(1) per
+ * moved rock, and a query walks only the rocks of one bucket instead of all of them.
+ *
+ * While the map has no more than about four cells per rock (or is small anyway), every bucket is a single cell and a
+ * query is O(rocks in the cell). On larger maps square blocks of cells share a bucket, so memory stays proportional to
+ * the number of rocks instead of the area of the map.
+ */
+class RockGrid
+{
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    RockGrid(uint32_t mapSize, uint32_t numRocks)
+        : mapSize(mapSize), next(numRocks, NONE), prev(numRocks, NONE), row(numRocks, NONE), col(numRocks, NONE),
+          bucket(numRocks, NONE)
+    {
+        const uint64_t maxBuckets = std::max<uint64_t>(4ull * numRocks, 1ull << 20);
+        blockSize = 1;
+        while ((uint64_t)blocks() * blocks() > maxBuckets)
+        {
+            blockSize *= 2;
+        }
+        head.assign((uint64_t)blocks() * blocks(), NONE);
+    }
+
+    /*
+     * Puts the rock into cell (r, c), inserting it on first use and moving it otherwise. A rock outside the map (the
+     * position update can wrap below zero) is not in any bucket.
+     */
+    void place(uint32_t rock, uint32_t r, uint32_t c)
+    {
+        if (move(rock, r, c))
+        {
+            relink(rock);
+        }
+    }
+
+    /*
+     * The part of place() that only touches the entries of this rock, so different threads may move different rocks
+     * at the same time. Returns whether the rock left its bucket and still has to be relinked.
+     */
+    bool move(uint32_t rock, uint32_t r, uint32_t c)
+    {
+        row[rock] = r;
+        col[rock] = c;
+        return bucket[rock] != target_of(r, c);
+    }
+
+    /*
+     * Moves the rock into the bucket of the cell given to move(). This changes the lists of two buckets, so only one
+     * thread may relink at a time.
+     */
+    void relink(uint32_t rock)
+    {
+        const uint32_t target = target_of(row[rock], col[rock]);
+        if (bucket[rock] == target)
+        {
+            return;
+        }
+        if (bucket[rock] != NONE)
+        {
+            unlink(rock);
+        }
+        bucket[rock] = target;
+        if (target == NONE)
+        {
+            return;
+        }
+        prev[rock] = NONE;
+        next[rock] = head[target];
+        if (head[target] != NONE)
+        {
+            prev[head[target]] = rock;
+        }
+        head[target] = rock;
+    }
+
+    /*
+     * Calls f(rock) for every rock in cell (r, c).
+     */
+    template <typename F>
+    void for_each(uint32_t r, uint32_t c, F f) const
+    {
+        if (r >= mapSize || c >= mapSize)
+        {
+            return;
+        }
+        for (uint32_t rock = head[bucket_of(r, c)]; rock != NONE; rock = next[rock])
+        {
+            if (row[rock] == r && col[rock] == c)
+            {
+                f(rock);
+            }
+        }
+    }
+
+    unsigned int count(uint32_t r, uint32_t c) const
+    {
+        unsigned int hits = 0;
+        for_each(r, c, [&hits](uint32_t)
+                 { hits++; });
+        return hits;
+    }
+
+private:
+    uint32_t blocks() const
+    {
+        return (mapSize + blockSize - 1) / blockSize;
+    }
+
+    uint32_t bucket_of(uint32_t r, uint32_t c) const
+    {
+        return r / blockSize * blocks() + c / blockSize;
+    }
+
+    uint32_t target_of(uint32_t r, uint32_t c) const
+    {
+        return r < mapSize && c < mapSize ? bucket_of(r, c) : NONE;
+    }
+
+    void unlink(uint32_t rock)
+    {
+        if (prev[rock] != NONE)
+        {
+            next[prev[rock]] = next[rock];
+        }
+        else
+        {
+            head[bucket[rock]] = next[rock];
+        }
+        if (next[rock] != NONE)
+        {
+            prev[next[rock]] = prev[rock];
+        }
+    }
+
+    uint32_t mapSize;
+    uint32_t blockSize;
+    std::vector<uint32_t> head;
+    std::vector<uint32_t> next, prev;
+    std::vector<uint32_t> row, col, bucket;
+};
+
+#endif // ROCK_GRID_H
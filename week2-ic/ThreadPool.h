@@ -0,0 +1,205 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Profiler.h"
+
+/*
+ * A fixed set of worker threads that run parallel loops with work stealing.
+ *
+ * parallel_for() splits the iteration space into chunks and hands every worker a contiguous range of them. A worker
+ * takes chunks from the front of its own range; once that is empty it steals the back half of another worker's range
+ * (or its last chunk). Each range is a single 64-bit word (begin and end chunk), so both taking and stealing are one
+ * compare-and-swap and no locks are involved while the loop runs. The calling thread takes part as worker 0, so a pool
+ * of size n starts n - 1 threads.
+ */
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(unsigned int numWorkers = std::thread::hardware_concurrency())
+        : numWorkers(std::max(1u, numWorkers)), ranges(new Range[this->numWorkers])
+    {
+        for (unsigned int worker = 1; worker < this->numWorkers; worker++)
+        {
+            threads.emplace_back(&WorkStealingPool::worker_loop, this, worker);
+        }
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    unsigned int size() const
+    {
+        return numWorkers;
+    }
+
+    /*
+     * Calls body(begin, end, worker) for consecutive pieces [begin, end) of [0, count) with at most chunkSize elements
+     * each, and returns once all of them are done. worker is the index (< size()) of the worker running the piece, for
+     * per-worker state such as counters.
+     */
+    template <typename Body>
+    void parallel_for(uint32_t count, uint32_t chunkSize, Body body)
+    {
+        chunkSize = std::max(1u, chunkSize);
+        const uint32_t numChunks = (count + chunkSize - 1) / chunkSize;
+        task = [&body, count, chunkSize](uint32_t chunk, unsigned int worker)
+        {
+            const uint32_t begin = chunk * chunkSize;
+            body(begin, std::min(count, begin + chunkSize), worker);
+        };
+
+        for (unsigned int worker = 0; worker < numWorkers; worker++)
+        {
+            const uint32_t begin = (uint64_t)numChunks * worker / numWorkers;
+            const uint32_t end = (uint64_t)numChunks * (worker + 1) / numWorkers;
+            ranges[worker].bounds.store(pack(begin, end), std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active = numWorkers;
+            generation++;
+        }
+        wake.notify_all();
+
+        run(0);
+
+        ScopedPhase phase(PHASE_THREAD_JOIN);
+        std::unique_lock<std::mutex> lock(mutex);
+        active--;
+        done.wait(lock, [this]
+                  { return active == 0; });
+        task = nullptr;
+    }
+
+private:
+    struct alignas(64) Range
+    {
+        std::atomic<uint64_t> bounds;
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end)
+    {
+        return (uint64_t)begin << 32 | end;
+    }
+
+    static uint32_t begin_of(uint64_t bounds)
+    {
+        return bounds >> 32;
+    }
+
+    static uint32_t end_of(uint64_t bounds)
+    {
+        return (uint32_t)bounds;
+    }
+
+    void worker_loop(unsigned int worker)
+    {
+        unsigned long seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen]
+                          { return stopping || generation != seen; });
+                if (stopping)
+                {
+                    return;
+                }
+                seen = generation;
+            }
+
+            run(worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active == 0)
+            {
+                done.notify_one();
+            }
+        }
+    }
+
+    void run(unsigned int worker)
+    {
+        uint32_t chunk;
+        while (take(worker, chunk) || steal(worker, chunk))
+        {
+            task(chunk, worker);
+        }
+    }
+
+    bool take(unsigned int worker, uint32_t &chunk)
+    {
+        std::atomic<uint64_t> &bounds = ranges[worker].bounds;
+        uint64_t current = bounds.load(std::memory_order_acquire);
+        while (begin_of(current) < end_of(current))
+        {
+            if (bounds.compare_exchange_weak(current, pack(begin_of(current) + 1, end_of(current)),
+                                             std::memory_order_acq_rel))
+            {
+                chunk = begin_of(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * Only called once the thief's own range is empty. Nobody else touches an empty range, so the thief can simply
+     * store the stolen chunks into it.
+     */
+    bool steal(unsigned int thief, uint32_t &chunk)
+    {
+        for (unsigned int offset = 1; offset < numWorkers; offset++)
+        {
+            std::atomic<uint64_t> &bounds = ranges[(thief + offset) % numWorkers].bounds;
+            uint64_t current = bounds.load(std::memory_order_acquire);
+            while (begin_of(current) < end_of(current))
+            {
+                const uint32_t begin = begin_of(current);
+                const uint32_t end = end_of(current);
+                const uint32_t middle = begin + (end - begin) / 2;
+                if (bounds.compare_exchange_weak(current, pack(begin, middle), std::memory_order_acq_rel))
+                {
+                    chunk = middle;
+                    ranges[thief].bounds.store(pack(middle + 1, end), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    const unsigned int numWorkers;
+    std::unique_ptr<Range[]> ranges;
+    std::vector<std::thread> threads;
+    std::function<void(uint32_t, unsigned int)> task;
+
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    unsigned long generation = 0;
+    unsigned int active = 0;
+    bool stopping = false;
+};
+
+#endif // THREAD_POOL_H
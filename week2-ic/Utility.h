@@ -15,10 +15,10 @@
 #define MAX_X 5.0
 #define MAX_VELO 3.0
 
-unsigned int rocks_pos[ROCKS_NUM][2];
-double rocks_vel[ROCKS_NUM][2];
-double datapoints[NUM_DATAPOINTS][2];
-char map[MAP_SIZE][MAP_SIZE] = {};
+inline unsigned int rocks_pos[ROCKS_NUM][2];
+inline double rocks_vel[ROCKS_NUM][2];
+inline double datapoints[NUM_DATAPOINTS][2];
+inline char map[MAP_SIZE][MAP_SIZE] = {};
 
 /*
  * This function outputs the result. 
@@ -33,24 +33,24 @@ public:
 
     void tic()
     {
-        start = std::chrono::system_clock::now();
+        start = std::chrono::steady_clock::now();
     }
 
     double toc()
     {
-        end = std::chrono::system_clock::now();
+        end = std::chrono::steady_clock::now();
         std::chrono::duration<double> elapsed_seconds = end - start;
         return elapsed_seconds.count() * 1000;
     }
 
 private:
-    std::chrono::time_point<std::chrono::system_clock> start, end;
+    std::chrono::time_point<std::chrono::steady_clock> start, end;
 };
 
 /*
  * Initializes seed for randomized testing.
  */
-static unsigned int readInput()
+inline unsigned int readInput()
 {
     std::cout << "READY" << std::endl;
     unsigned int seed = 0;
@@ -68,7 +68,7 @@ static unsigned int readInput()
 /*
  * Generates random tests.
  */
-static void generate_test(unsigned int rocks_pos[][2], double rocks_vel[][2], double datapoints[][2], unsigned int seed)
+inline void generate_test(unsigned int rocks_pos[][2], double rocks_vel[][2], double datapoints[][2], unsigned int seed)
 {
     std::minstd_rand0 generator(seed); // linear congruential random number generator.
 
@@ -89,7 +89,7 @@ static void generate_test(unsigned int rocks_pos[][2], double rocks_vel[][2], do
 /*
  * This function outputs the decryptedMessage. 
  */
-static void outputResult(unsigned int crashed_count)
+inline void outputResult(unsigned int crashed_count)
 {
 
     std::cout << "Total crashed count: " << crashed_count << std::endl
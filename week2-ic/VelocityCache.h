@@ -0,0 +1,148 @@
+#ifndef VELOCITY_CACHE_H
+#define VELOCITY_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/*
+ * Memoizes the interpolating polynomial: a lock-free open addressing table from the bit pattern of x to the bit
+ * pattern of the polynomial at x.
+ *
+ * x = fmod(pow(vel, pos % count), MAX_X) is all the polynomial depends on, and rock trajectories collapse onto few
+ * values of it: with the default sizes roughly a thousand distinct x occur among the 96000 evaluations. Keys are exact
+ * bit patterns and the polynomial is deterministic, so a cached value is the value the evaluation would have produced.
+ *
+ * A slot is claimed by a compare-and-swap on its key, and the value is published afterwards. A reader that finds the
+ * key before the value simply treats it as a miss. Two threads that miss on the same x both evaluate it and store the
+ * same value. When MAX_PROBES slots are taken the value is not cached at all, so a full table degrades to evaluating
+ * everything but never blocks.
+ */
+class VelocityCache
+{
+public:
+    void resize(size_t minEntries)
+    {
+        size_t capacity = 1 << 12;
+        shift = 64 - 12;
+        while (capacity < 2 * minEntries && capacity < (1 << 24))
+        {
+            capacity *= 2;
+            shift--;
+        }
+        slots.reset(new Slot[capacity]);
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; i++)
+        {
+            slots[i].key.store(EMPTY, std::memory_order_relaxed);
+            slots[i].value.store(EMPTY, std::memory_order_relaxed);
+        }
+        hitCount.store(0);
+        missCount.store(0);
+    }
+
+    bool find(double x, double &result) const
+    {
+        const uint64_t key = bits_of(x);
+        if (key == EMPTY)
+        {
+            return false;
+        }
+        for (uint64_t i = hash(key), probe = 0; probe < MAX_PROBES; i = (i + 1) & mask, probe++)
+        {
+            const uint64_t current = slots[i].key.load(std::memory_order_acquire);
+            if (current == key)
+            {
+                const uint64_t value = slots[i].value.load(std::memory_order_acquire);
+                memcpy(&result, &value, sizeof(result));
+                return value != EMPTY;
+            }
+            if (current == EMPTY)
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    void insert(double x, double result)
+    {
+        const uint64_t key = bits_of(x);
+        const uint64_t value = bits_of(result);
+        if (key == EMPTY || value == EMPTY)
+        {
+            return;
+        }
+        for (uint64_t i = hash(key), probe = 0; probe < MAX_PROBES; i = (i + 1) & mask, probe++)
+        {
+            uint64_t current = slots[i].key.load(std::memory_order_acquire);
+            if (current == EMPTY &&
+                slots[i].key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+            {
+                slots[i].value.store(value, std::memory_order_release);
+                return;
+            }
+            if (current == key)
+            {
+                return;
+            }
+        }
+    }
+
+    // Callers count per worker and report their totals once at the end, so the counters are never contended.
+    void record(uint64_t hits, uint64_t misses)
+    {
+        hitCount.fetch_add(hits, std::memory_order_relaxed);
+        missCount.fetch_add(misses, std::memory_order_relaxed);
+    }
+
+    uint64_t hits() const
+    {
+        return hitCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const
+    {
+        return missCount.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+    struct alignas(16) Slot
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> value;
+    };
+
+    // A NaN that the arithmetic never produces (x86 generates 0xfff8000000000000), marking empty keys and values.
+    static constexpr uint64_t EMPTY = ~0ull;
+    static constexpr uint64_t MAX_PROBES = 16;
+
+    static uint64_t bits_of(double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Fibonacci hashing: the top bits of the product depend on all bits of the key, and many x have few low bits set.
+    uint64_t hash(uint64_t key) const
+    {
+        return key * 0x9e3779b97f4a7c15ull >> shift;
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    uint64_t mask = 0;
+    int shift = 64;
+    alignas(64) std::atomic<uint64_t> hitCount{0};
+    alignas(64) std::atomic<uint64_t> missCount{0};
+};
+
+inline VelocityCache velocity_cache;
+
+#endif // VELOCITY_CACHE_H
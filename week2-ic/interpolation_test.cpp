@@ -0,0 +1,103 @@
+#include "Utility.h"
+#include "Interpolation.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+/*
+ * Checks that interpolate() and interpolate_lanes() reproduce the original Neville tableau of compute_vel() bit for bit,
+ * both the raw value of the polynomial and the velocity after the fmod() wraps. The datapoints are those of
+ * generate_test() for a number of seeds, the positions and velocities are random, including negative velocities and
+ * positions far beyond NUM_DATAPOINTS, so pos % NUM_DATAPOINTS and both fmod() calls wrap.
+ *
+ *   make test
+ */
+
+constexpr int SEEDS = 8;
+constexpr int INPUTS_PER_SEED = 2000;
+
+// compute_vel() from sequential_implementation.cpp, returning the polynomial before the fmod() as well.
+static double original_vel(unsigned int pos, double current_vel, double &polynomial)
+{
+    double x = std::fmod(std::pow(current_vel, pos % NUM_DATAPOINTS), MAX_X);
+    static double p[NUM_DATAPOINTS][NUM_DATAPOINTS];
+
+    for (int i = 0; i < NUM_DATAPOINTS; i++)
+    {
+        p[i][0] = datapoints[i][1];
+    }
+
+    for (int k = 1; k < NUM_DATAPOINTS; k++)
+    {
+        for (int i = 0; i < NUM_DATAPOINTS - k; i++)
+        {
+            p[i][k] = p[i][k - 1] + ((x - datapoints[i][0]) / (datapoints[i + k][0] - datapoints[i][0])) * (p[i + 1][k - 1] - p[i][k - 1]);
+        }
+    }
+
+    polynomial = p[0][NUM_DATAPOINTS - 1];
+    return std::fmod(polynomial, MAX_VELO);
+}
+
+static bool same_bits(double a, double b)
+{
+    uint64_t bitsA, bitsB;
+    memcpy(&bitsA, &a, sizeof(a));
+    memcpy(&bitsB, &b, sizeof(b));
+    return bitsA == bitsB;
+}
+
+int main()
+{
+    std::mt19937_64 generator(2024);
+    std::uniform_int_distribution<unsigned int> position(0, 100 * MAP_SIZE);
+    std::uniform_real_distribution<double> velocity(-MAX_VELO, MAX_VELO);
+
+    InterpolationScratch scratch;
+    uint64_t evaluations = 0, wrapped = 0, failures = 0;
+    for (unsigned int seed = 1; seed <= SEEDS; seed++)
+    {
+        generate_test(rocks_pos, rocks_vel, datapoints, seed);
+        prepare_interpolation(datapoints, NUM_DATAPOINTS);
+        prepare_scratch(scratch);
+
+        for (int n = 0; n < INPUTS_PER_SEED; n += INTERPOLATION_LANES)
+        {
+            alignas(64) double x[INTERPOLATION_LANES];
+            alignas(64) double lanes[INTERPOLATION_LANES];
+            double expected[INTERPOLATION_LANES], expectedVel[INTERPOLATION_LANES];
+            for (int l = 0; l < INTERPOLATION_LANES; l++)
+            {
+                // Every other input is a rock of the generated test, the others are arbitrary.
+                const int rock = (n + l) % ROCKS_NUM;
+                const unsigned int pos = l % 2 ? rocks_pos[rock][0] : position(generator);
+                const double vel = l % 2 ? rocks_vel[rock][1] : velocity(generator);
+                expectedVel[l] = original_vel(pos, vel, expected[l]);
+                x[l] = std::fmod(std::pow(vel, pos % interpolation.count), MAX_X);
+                wrapped += std::fabs(std::pow(vel, pos % interpolation.count)) >= MAX_X ||
+                           std::fabs(expected[l]) >= MAX_VELO;
+            }
+            interpolate_lanes(x, lanes, scratch);
+
+            for (int l = 0; l < INTERPOLATION_LANES; l++)
+            {
+                const double scalar = interpolate(x[l], scratch);
+                evaluations++;
+                if (!same_bits(scalar, expected[l]) || !same_bits(lanes[l], expected[l]) ||
+                    !same_bits(std::fmod(scalar, MAX_VELO), expectedVel[l]))
+                {
+                    if (failures++ < 10)
+                    {
+                        std::cerr << "seed " << seed << ", x = " << x[l] << ": tableau " << expected[l]
+                                  << ", interpolate " << scalar << ", interpolate_lanes " << lanes[l] << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << evaluations << " evaluations (" << wrapped << " through an fmod wrap), " << failures << " mismatches"
+              << std::endl;
+    return failures == 0 && wrapped > 0 ? 0 : 1;
+}
@@ -1,135 +1,322 @@
+// uncomment this line to time the phases of the run and write their histograms as JSON at exit (see Profiler.h)
+// #define PROFILE_PHASES
+
 #include "Utility.h"
+#include "Interpolation.h"
 #include <chrono>
 #include <stdlib.h>
 #include <unistd.h>
-// ######################## TODO: include library for enabling thread and mutex ########################
-
-// ######################## TODO END ########################
+#include "RockCycle.h"
+#include "RockGrid.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include "VelocityCache.h"
+#include <cmath>
+#include <memory>
+#include <vector>
 
 // uncomment this line to print used time
 // comment this line before submission
 #define PRINT_TIME 1
 
-int task_id = 0;
-// TODO: uncomment once you added the correct headers
-// std::thread threads[THREAD_NUM];
-// std::mutex mutex;
+// uncomment this line to evaluate the velocity polynomial in Newton form, O(datapoints) instead of
+// O(datapoints^2); the crashed count then no longer matches the sequential implementation (see Interpolation.h)
+// #define NEWTON_INTERPOLATION
+
+// uncomment this line to look up repeated inputs of the velocity polynomial in a memoization cache instead of
+// evaluating it for every rock (see VelocityCache.h); the results are identical either way
+// #define VELOCITY_CACHE
+
+/*
+ * The size of the problem, given on the command line:
+ *   ./student_submission [rocks [map-size [datapoints [steps]]]]
+ * The defaults are ROCKS_NUM, MAP_SIZE and NUM_DATAPOINTS from Utility.h, i.e. the original problem, which runs
+ * map-size steps. Given a step count, the ship keeps moving along the diagonal, at (i mod map-size, i mod map-size)
+ * in step i, and every rock is fast-forwarded through its trajectory cycle (see RockCycle.h) instead of simulated.
+ */
+struct SimulationConfig
+{
+    uint32_t rocks = ROCKS_NUM;
+    uint32_t mapSize = MAP_SIZE;
+    int datapoints = NUM_DATAPOINTS;
+    uint64_t steps = MAP_SIZE;
+    bool fastForward = false;
+};
+
+// One crash counter per worker, each on its own cache line, summed once all rocks are done.
+struct alignas(64) CrashCounter
+{
+    uint64_t count = 0;
+};
+
+// The state a worker keeps across update_rocks() calls, on cache lines of its own.
+struct alignas(64) RockWorker
+{
+    InterpolationScratch scratch;
+#ifdef VELOCITY_CACHE
+    // Counted here and folded into velocity_cache once at the end, so no update touches a shared counter.
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+#endif
+};
 
-void compute_vel(unsigned int pos, double current_vel, double *target_vel)
+// The rocks a worker moved into another bucket of the grid during one step, relinked once the step is done.
+struct alignas(64) MovedRocks
 {
+    std::vector<uint32_t> rocks;
+};
+
+// Rocks per chunk of the work-stealing loop: their rows, and then their columns, fill one vector of interpolate_lanes().
+constexpr int ROCKS_PER_CHUNK = INTERPOLATION_LANES;
 
-    double x = std::fmod(std::pow(current_vel, pos % NUM_DATAPOINTS), MAX_X);
-    /*
-     * You do not have to modify or understand this code.
-     * But in your free time, if you manage to find an optimization to this algorithm (maybe another algorithm?), 
-     * you will get our personal appreciation.
-     * This algorithm is not relevant for the exam and is not part of the course material. 
-     */
-    double p[NUM_DATAPOINTS][NUM_DATAPOINTS];
+// The state of all rocks as structure-of-arrays: the rows of all rocks, then the columns of all rocks.
+std::vector<unsigned int> positions;
+std::vector<double> velocities;
 
-    for (int i = 0; i < NUM_DATAPOINTS; i++)
+static bool parse_config(int argc, char *argv[], SimulationConfig &config)
+{
+    unsigned long long values[4] = {config.rocks, config.mapSize, (unsigned long long)config.datapoints, 0};
+    if (argc > 5)
     {
-        p[i][0] = datapoints[i][1];
+        return false;
     }
-
-    for (int k = 1; k < NUM_DATAPOINTS; k++)
+    for (int i = 1; i < argc; i++)
     {
-        for (int i = 0; i < NUM_DATAPOINTS - k; i++)
+        char *end;
+        values[i - 1] = strtoull(argv[i], &end, 10);
+        if (*end != '\0' || (i < 4 && values[i - 1] > UINT32_MAX))
         {
-            p[i][k] = p[i][k - 1] + ((x - datapoints[i][0]) / (datapoints[i + k][0] - datapoints[i][0])) * (p[i + 1][k - 1] - p[i][k - 1]);
+            return false;
         }
     }
-
-    *target_vel = std::fmod(p[0][NUM_DATAPOINTS - 1], MAX_VELO);
+    config.rocks = values[0];
+    config.mapSize = values[1];
+    config.datapoints = values[2];
+    config.fastForward = argc > 4;
+    config.steps = config.fastForward ? values[3] : config.mapSize;
+    return config.mapSize > 0 && config.datapoints > 0 && values[2] <= INT32_MAX;
 }
 
-void update_rock_pos(int rock_id, unsigned int local_rocks_pos[][2], double local_rocks_vel[][2])
+/*
+ * generate_test() for a problem of any size: the same generator draws the same numbers in the same order, so the
+ * default configuration yields exactly the original test. Datapoints beyond the number of rocks are drawn after them.
+ */
+static void generate_rocks(const SimulationConfig &config, unsigned int seed, double (*points)[2])
 {
-    unsigned int &rock_r = local_rocks_pos[rock_id][0];
-    unsigned int &rock_c = local_rocks_pos[rock_id][1];
-    double &rock_vr = local_rocks_vel[rock_id][0];
-    double &rock_vc = local_rocks_vel[rock_id][1];
-    compute_vel(rock_r, rock_vr, &rock_vr);
-    compute_vel(rock_c, rock_vc, &rock_vc);
-    double tmp = rock_r + rock_vr;
-
-    rock_r = (unsigned int)((long)tmp % MAP_SIZE);
-
-    tmp = rock_c + rock_vc;
-    rock_c = (unsigned int)((long)tmp % MAP_SIZE);
+    std::minstd_rand0 generator(seed);
+    const uint32_t rocks = config.rocks;
+    positions.resize(2 * (size_t)rocks);
+    velocities.resize(2 * (size_t)rocks);
+    for (uint32_t i = 0; i < std::max<uint32_t>(rocks, config.datapoints); i++)
+    {
+        if (i < rocks)
+        {
+            positions[i] = generator() % config.mapSize;
+            positions[rocks + i] = generator() % config.mapSize;
+            velocities[i] = MAX_VELO * double(generator()) / double(std::minstd_rand0::max());
+            velocities[rocks + i] = MAX_VELO * double(generator()) / double(std::minstd_rand0::max());
+        }
+        if (i < (uint32_t)config.datapoints)
+        {
+            points[i][0] = MAX_X * double(generator()) / double(std::minstd_rand0::max());
+            points[i][1] = MAX_X * double(generator()) / double(std::minstd_rand0::max());
+        }
+    }
 }
 
-void working_thread(int &buffer)
+/*
+ * The velocity polynomial at x[0..count), count <= INTERPOLATION_LANES.
+ */
+static void evaluate_polynomial(const double *x, double *p, int count, InterpolationScratch &scratch)
 {
+#ifdef NEWTON_INTERPOLATION
+    (void)scratch;
+    for (int l = 0; l < count; l++)
+    {
+        p[l] = interpolate_newton(x[l]);
+    }
+#else
+    if (count == INTERPOLATION_LANES)
+    {
+        interpolate_lanes(x, p, scratch);
+    }
+    else
+    {
+        // A partially filled vector costs as much as a full one; the tail is cheaper one by one.
+        for (int l = 0; l < count; l++)
+        {
+            p[l] = interpolate(x[l], scratch);
+        }
+    }
+#endif
+}
 
-    // define rocks' pos and vel arrays for local thread
-    unsigned int local_rocks_pos[ROCKS_NUM / THREAD_NUM][2];
-    double local_rocks_vel[ROCKS_NUM / THREAD_NUM][2];
-    int local_crashed_count = 0;
-
-    int local_task_id;
-    // ######################## TODO: Copy task id from the global variable and increment it ########################
-    // ######################## DO NOT FORGET TO LOCK AND UNLOCK! ########################
-
-
-    // ######################## TODO END ########################
-
-    // start index for global array
-    int rock_si = local_task_id * ROCKS_NUM / THREAD_NUM;
-
-    // copy
-    memcpy(local_rocks_pos, &rocks_pos[rock_si][0], ROCKS_NUM / THREAD_NUM * 2 * sizeof(unsigned int));
-    memcpy(local_rocks_vel, &rocks_vel[rock_si][0], ROCKS_NUM / THREAD_NUM * 2 * sizeof(double));
-
-    // This is the main work done by the thread
-    for (unsigned int i = 0; i < MAP_SIZE; i++)
+/*
+ * Moves count rocks by one step. pos and vel are structure-of-arrays over (rock, axis) pairs: each entry is one
+ * coordinate of one rock and evolves independently of all others, so the velocity polynomial is evaluated for
+ * INTERPOLATION_LANES entries at once. pow() and fmod() stay scalar library calls: the interpolant amplifies every
+ * rounding difference in x, and only the exact results of the library functions reproduce the crashed count of the
+ * sequential implementation.
+ */
+void update_rocks(unsigned int *pos, double *vel, int count, uint32_t mapSize, RockWorker &worker)
+{
+    ScopedPhase phase(PHASE_VELOCITY_UPDATE);
+    for (int j = 0; j < count; j += INTERPOLATION_LANES)
     {
-        // computationally expensive tasks
-        for (unsigned int k = 0; k < ROCKS_NUM / THREAD_NUM; k++)
+        const int lanes = std::min(INTERPOLATION_LANES, count - j);
+        alignas(64) double x[INTERPOLATION_LANES] = {};
+        alignas(64) double p[INTERPOLATION_LANES];
+        for (int l = 0; l < lanes; l++)
+        {
+            x[l] = std::fmod(std::pow(vel[j + l], pos[j + l] % interpolation.count), MAX_X);
+        }
+#ifdef VELOCITY_CACHE
+        // Only the inputs missing from the cache are evaluated, packed to the front of a vector.
+        alignas(64) double missed[INTERPOLATION_LANES] = {};
+        alignas(64) double evaluated[INTERPOLATION_LANES];
+        int lane[INTERPOLATION_LANES];
+        int misses = 0;
+        for (int l = 0; l < lanes; l++)
         {
-            update_rock_pos(k, local_rocks_pos, local_rocks_vel);
-            auto &row = local_rocks_pos[k][0];
-            auto &col = local_rocks_pos[k][1];
-            if (row == i && col == i)
+            if (!velocity_cache.find(x[l], p[l]))
             {
-                local_crashed_count++;
+                lane[misses] = l;
+                missed[misses++] = x[l];
             }
         }
+        evaluate_polynomial(missed, evaluated, misses, worker.scratch);
+        for (int m = 0; m < misses; m++)
+        {
+            p[lane[m]] = evaluated[m];
+            velocity_cache.insert(missed[m], evaluated[m]);
+        }
+        worker.cacheHits += lanes - misses;
+        worker.cacheMisses += misses;
+#else
+        evaluate_polynomial(x, p, lanes, worker.scratch);
+#endif
+        for (int l = 0; l < lanes; l++)
+        {
+            vel[j + l] = std::fmod(p[l], MAX_VELO);
+            double tmp = pos[j + l] + vel[j + l];
+            pos[j + l] = (unsigned int)((long)tmp % (long)mapSize);
+        }
     }
-
-    //return the value to the buffer 
-    buffer = local_crashed_count;
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+    SimulationConfig config;
+    if (!parse_config(argc, argv, config))
+    {
+        std::cerr << "Usage: " << argv[0] << " [rocks [map-size [datapoints [steps]]]]" << std::endl;
+        return 1;
+    }
+
     unsigned int seed = readInput();
 #ifdef PRINT_TIME
     TicToc total_time;
 #endif
-    generate_test(rocks_pos, rocks_vel, datapoints, seed);
-    unsigned int crashed_count = 0;
-    //This is a buffer for receiving the output
-    int buffer[THREAD_NUM];
-
-    task_id = 0;
-    for (int thread_id = 0; thread_id < THREAD_NUM; thread_id++)
+    const uint32_t rocks = config.rocks;
+    std::unique_ptr<double[][2]> points(new double[config.datapoints][2]);
     {
-        // ######################## TODO: create thread to call the working_thread function and pass the buffer element as argument ########################
-
-        // ######################## TODO END ########################
+        ScopedPhase phase(PHASE_GENERATE_TEST);
+        generate_rocks(config, seed, points.get());
+    }
+    {
+        ScopedPhase phase(PHASE_PREPARE);
+        prepare_interpolation(points.get(), config.datapoints);
+#ifdef VELOCITY_CACHE
+        velocity_cache.resize(2 * (size_t)rocks);
+#endif
     }
 
-    for (int thread_id = 0; thread_id < THREAD_NUM; thread_id++)
+    // Sized to the machine, and the chunks are balanced at run time, so any core count works without recompiling.
+    WorkStealingPool pool;
+    std::vector<RockWorker> workers(pool.size());
+    for (RockWorker &worker : workers)
     {
-        // ######################## TODO: join thread to terminate thread, get the returned value from the buffer and add it to the (total) crashed_count ########################
+        prepare_scratch(worker.scratch);
+    }
+    if (config.fastForward)
+    {
+        std::vector<CrashCounter> counters(pool.size());
+        pool.parallel_for(rocks, 1, [rocks, &config, &counters, &workers](uint32_t k, uint32_t, unsigned int worker)
+                          {
+                              ScopedPhase phase(PHASE_FAST_FORWARD);
+                              const RockState rock = {{positions[k], positions[rocks + k]},
+                                                      {velocities[k], velocities[rocks + k]}};
+                              counters[worker].count += count_rock_hits(
+                                  rock, config.steps, config.mapSize,
+                                  [&config, &workers, worker](RockState &state)
+                                  { update_rocks(state.pos, state.vel, 2, config.mapSize, workers[worker]); });
+                          });
 
-        // ######################## TODO END ########################
+        uint64_t crashed_count = 0;
+        for (const CrashCounter &counter : counters)
+        {
+            crashed_count += counter.count;
+        }
+        // outputResult() with a count that may not fit into unsigned int
+        std::cout << "Total crashed count: " << crashed_count << std::endl
+                  << "DONE" << std::endl;
     }
-        
+    else
+    {
+        RockGrid grid(config.mapSize, rocks);
+        for (uint32_t k = 0; k < rocks; k++)
+        {
+            grid.place(k, positions[k], positions[rocks + k]);
+        }
 
-    outputResult(crashed_count);
+        unsigned int crashed_count = 0;
+        std::vector<MovedRocks> moved(pool.size());
+        for (unsigned int i = 0; i < config.mapSize; i++)
+        {
+            pool.parallel_for(rocks, ROCKS_PER_CHUNK,
+                              [rocks, &config, &workers, &grid, &moved](uint32_t begin, uint32_t end, unsigned int worker)
+                              {
+                                  update_rocks(&positions[begin], &velocities[begin], end - begin, config.mapSize,
+                                               workers[worker]);
+                                  update_rocks(&positions[rocks + begin], &velocities[rocks + begin], end - begin,
+                                               config.mapSize, workers[worker]);
+                                  // Each rock belongs to one chunk, so the cells are recorded in parallel as well.
+                                  for (uint32_t k = begin; k < end; k++)
+                                  {
+                                      if (grid.move(k, positions[k], positions[rocks + k]))
+                                      {
+                                          moved[worker].rocks.push_back(k);
+                                      }
+                                  }
+                              });
+            // Only the rocks that left their bucket are relinked; the ship's cell is then one short list away.
+            ScopedPhase phase(PHASE_HIT_COUNTING);
+            for (MovedRocks &worker : moved)
+            {
+                for (uint32_t k : worker.rocks)
+                {
+                    grid.relink(k);
+                }
+                worker.rocks.clear();
+            }
+            crashed_count += grid.count(i, i);
+        }
+
+        outputResult(crashed_count);
+    }
+#ifdef VELOCITY_CACHE
+    for (const RockWorker &worker : workers)
+    {
+        velocity_cache.record(worker.cacheHits, worker.cacheMisses);
+    }
+#endif
 #ifdef PRINT_TIME
     std::cerr << "time used: " << total_time.toc() << "ms.\n";
+#ifdef VELOCITY_CACHE
+    const uint64_t lookups = velocity_cache.hits() + velocity_cache.misses();
+    std::cerr << "velocity cache: " << velocity_cache.hits() << " hits, " << velocity_cache.misses() << " misses ("
+              << (lookups ? 100.0 * velocity_cache.hits() / lookups : 0.0) << "% hit rate, "
+              << velocity_cache.capacity() << " slots)\n";
 #endif
-}
\ No newline at end of file
+#endif
+}